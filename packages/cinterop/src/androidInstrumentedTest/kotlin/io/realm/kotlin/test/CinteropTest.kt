@@ -586,7 +586,9 @@ class CinteropTest {
             integer = 123
         }
         realmc.realm_set_value(foo1, foo_int_property.key, realm_value_t().apply { type = realm_value_type_e.RLM_TYPE_INT; integer = 123 }, false)
-        realmc.realm_set_value(foo1, foo_str_property.key, realm_value_t().apply { type = realm_value_type_e.RLM_TYPE_STRING; string = "Hello, World!" }, false)
+        // Strings of values are copied into an arena that is freed once the values are used
+        val arena = realmc.realm_value_arena_new()
+        realmc.realm_set_value(foo1, foo_str_property.key, realm_value_t().also { realmc.realm_value_set_string(it, "Hello, World!", arena) }, false)
         val bar1: Long = realmc.realm_object_create_with_primary_key(realm, bar_info.key, realm_value_t().apply { type = realm_value_type_e.RLM_TYPE_INT; integer = 1 })
 
         realmc.realm_get_value(foo1, foo_int_property.key, realm_value_t())
@@ -602,12 +604,10 @@ class CinteropTest {
             realm_query_arg_t().apply {
                 nb_args = 1
                 is_list = false
-                arg = realm_value_t().apply {
-                    type = realm_value_type_e.RLM_TYPE_STRING
-                    string = "Hello, World!"
-                }
+                arg = realm_value_t().also { realmc.realm_value_set_string(it, "Hello, World!", arena) }
             }
         )
+        realmc.realm_value_arena_free(arena)
 
         val count = LongArray(1)
         realmc.realm_query_count(query, count)
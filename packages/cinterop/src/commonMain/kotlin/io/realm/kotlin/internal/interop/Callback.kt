@@ -26,6 +26,19 @@ interface Callback<T : RealmNativePointer> {
     fun onChange(change: T)
 }
 
+/**
+ * Notification callback that only receives a change when it is ready for it. After receiving a
+ * change, changes are merged into a single pending change until the `ready` function passed to
+ * [onRegistered] is invoked. `ready` must be invoked on the thread delivering the notifications and
+ * only while the registration is active.
+ *
+ * Platforms not supporting merging changes deliver all changes right away and never invoke
+ * [onRegistered].
+ */
+interface CoalescingCallback<T : RealmNativePointer> : Callback<T> {
+    fun onRegistered(ready: () -> Unit)
+}
+
 // Callback from asynchronous sync methods. Use AppCallback<Unit> for void callbacks and
 // AppCallback<NativePointer> for callbacks with native pointers to core objects.
 interface AppCallback<T> {
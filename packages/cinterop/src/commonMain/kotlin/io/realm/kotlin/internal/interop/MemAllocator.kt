@@ -149,7 +149,9 @@ expect inline fun <R> getterScope(block: MemAllocator.() -> R): R
 //  leaking the allocators to the internal implementations.
 inline fun <R> inputScope(block: MemTrackingAllocator.() -> R): R {
     val allocator = trackingRealmValueAllocator()
-    val x = block(allocator)
-    allocator.free()
-    return x
+    try {
+        return block(allocator)
+    } finally {
+        allocator.free()
+    }
 }
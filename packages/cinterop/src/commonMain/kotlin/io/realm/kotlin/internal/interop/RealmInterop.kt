@@ -299,6 +299,16 @@ expect object RealmInterop {
     fun realm_get_col_key(realm: RealmPointer, classKey: ClassKey, col: String): PropertyKey
 
     fun MemAllocator.realm_get_value(obj: RealmObjectPointer, key: PropertyKey): RealmValue
+    /**
+     * Reads the values of multiple properties with a single call into the C-API. [keys] holds the
+     * raw [PropertyKey.key] values and the values of the resulting row are in the same order.
+     * Collection properties are not supported.
+     */
+    fun realm_get_values(obj: RealmObjectPointer, keys: LongArray): RealmValueRow
+    /**
+     * Sets the values of multiple properties with a single call into the C-API.
+     */
+    fun realm_set_values(obj: RealmObjectPointer, values: RealmValueRowBuilder, isDefault: Boolean)
     fun realm_set_value(
         obj: RealmObjectPointer,
         key: PropertyKey,
@@ -461,6 +471,19 @@ expect object RealmInterop {
 
     // FIXME OPTIMIZE Get many
     fun MemAllocator.realm_results_get(results: RealmResultsPointer, index: Long): RealmValue
+    /**
+     * Reads [count] elements starting at index [from] with a single call into the C-API.
+     */
+    fun realm_results_get_range(results: RealmResultsPointer, from: Long, count: Int): RealmValueRow
+    /**
+     * Reads the values of the property [key] of the objects in [results] into [values], which
+     * should be sized to the number of results. Null values are flagged in the [nulls] bitmap
+     * holding one bit per element.
+     */
+    fun realm_results_get_column(results: RealmResultsPointer, key: PropertyKey, values: LongArray, nulls: ByteArray)
+    fun realm_results_get_column(results: RealmResultsPointer, key: PropertyKey, values: DoubleArray, nulls: ByteArray)
+    fun realm_results_get_column(results: RealmResultsPointer, key: PropertyKey, values: FloatArray, nulls: ByteArray)
+    fun realm_results_get_column(results: RealmResultsPointer, key: PropertyKey, values: BooleanArray, nulls: ByteArray)
     fun realm_results_get_list(results: RealmResultsPointer, index: Long): RealmListPointer
     fun realm_results_get_dictionary(results: RealmResultsPointer, index: Long): RealmMapPointer
     fun realm_results_delete_all(results: RealmResultsPointer)
@@ -503,11 +526,10 @@ expect object RealmInterop {
     fun realm_object_changes_get_modified_properties(
         change: RealmChangesPointer
     ): List<PropertyKey>
-    fun <T, R> realm_collection_changes_get_indices(
-        change: RealmChangesPointer,
-        builder: CollectionChangeSetBuilder<T, R>
-    )
-    fun <T, R> realm_collection_changes_get_ranges(
+    /**
+     * Populates the indices and ranges of [builder] from a collection change set.
+     */
+    fun <T, R> realm_collection_changes_get_change_set(
         change: RealmChangesPointer,
         builder: CollectionChangeSetBuilder<T, R>
     )
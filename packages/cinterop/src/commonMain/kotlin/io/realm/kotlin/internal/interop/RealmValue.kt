@@ -16,6 +16,8 @@
 
 package io.realm.kotlin.internal.interop
 
+import org.mongodb.kbson.Decimal128
+
 /**
  * Representation of a C-API `realm_value_t` struct.
  */
@@ -63,3 +65,143 @@ expect class RealmQueryArgumentList
 sealed interface RealmQueryArgument
 class RealmQuerySingleArgument(val argument: RealmValue) : RealmQueryArgument
 class RealmQueryListArgument(val arguments: RealmValueList) : RealmQueryArgument
+
+/**
+ * Values of multiple properties of a single object, read with a single call into the C-API through
+ * [RealmInterop.realm_get_values].
+ *
+ * Opposite to [RealmValue], the values are fully decoded and do not reference any native memory,
+ * so the row can be kept around and read from any thread.
+ */
+class RealmValueRow(val size: Int) {
+    private val types: Array<ValueType> = Array(size) { ValueType.RLM_TYPE_NULL }
+    private val values: Array<Any?> = arrayOfNulls(size)
+
+    fun getType(index: Int): ValueType = types[index]
+
+    fun getLong(index: Int): Long = values[index] as Long
+    fun getBoolean(index: Int): Boolean = values[index] as Boolean
+    fun getString(index: Int): String = values[index] as String
+    fun getByteArray(index: Int): ByteArray = values[index] as ByteArray
+    fun getTimestamp(index: Int): Timestamp = values[index] as Timestamp
+    fun getFloat(index: Int): Float = values[index] as Float
+    fun getDouble(index: Int): Double = values[index] as Double
+    fun getObjectIdBytes(index: Int): ByteArray = values[index] as ByteArray
+    fun getUUIDBytes(index: Int): ByteArray = values[index] as ByteArray
+    fun getDecimal128Array(index: Int): ULongArray = values[index] as ULongArray
+    fun getLink(index: Int): Link = values[index] as Link
+    fun isNull(index: Int): Boolean = types[index] == ValueType.RLM_TYPE_NULL
+
+    internal operator fun set(index: Int, type: ValueType, value: Any?) {
+        types[index] = type
+        values[index] = value
+    }
+
+    @Suppress("ComplexMethod")
+    internal fun setValue(index: Int, value: RealmValue) {
+        val type = value.getType()
+        this[index, type] = when (type) {
+            ValueType.RLM_TYPE_INT -> value.getLong()
+            ValueType.RLM_TYPE_BOOL -> value.getBoolean()
+            ValueType.RLM_TYPE_STRING -> value.getString()
+            ValueType.RLM_TYPE_BINARY -> value.getByteArray()
+            ValueType.RLM_TYPE_TIMESTAMP -> value.getTimestamp()
+            ValueType.RLM_TYPE_FLOAT -> value.getFloat()
+            ValueType.RLM_TYPE_DOUBLE -> value.getDouble()
+            ValueType.RLM_TYPE_DECIMAL128 -> value.getDecimal128Array()
+            ValueType.RLM_TYPE_OBJECT_ID -> value.getObjectIdBytes()
+            ValueType.RLM_TYPE_UUID -> value.getUUIDBytes()
+            ValueType.RLM_TYPE_LINK -> value.getLink()
+            else -> null
+        }
+    }
+}
+
+/**
+ * Values of multiple properties of a single object to be set with a single call into the C-API
+ * through [RealmInterop.realm_set_values].
+ *
+ * Primitive values are kept unboxed, so adding values does not allocate once the builder has
+ * grown to the number of properties of the object.
+ */
+class RealmValueRowBuilder(capacity: Int = DEFAULT_CAPACITY) {
+    var size: Int = 0
+        private set
+
+    internal var keys: LongArray = LongArray(capacity)
+    internal var types: Array<ValueType> = Array(capacity) { ValueType.RLM_TYPE_NULL }
+    // Integers, booleans and the raw bits of floating point values
+    internal var primitives: LongArray = LongArray(capacity)
+    // Strings, binaries, timestamps, decimals, object ids and UUIDs
+    internal var objects: Array<Any?> = arrayOfNulls(capacity)
+
+    fun addNull(key: PropertyKey) = add(key, ValueType.RLM_TYPE_NULL, 0, null)
+    fun addLong(key: PropertyKey, value: Long) = add(key, ValueType.RLM_TYPE_INT, value, null)
+    fun addBoolean(key: PropertyKey, value: Boolean) =
+        add(key, ValueType.RLM_TYPE_BOOL, if (value) 1 else 0, null)
+    fun addFloat(key: PropertyKey, value: Float) =
+        add(key, ValueType.RLM_TYPE_FLOAT, value.toRawBits().toLong(), null)
+    fun addDouble(key: PropertyKey, value: Double) =
+        add(key, ValueType.RLM_TYPE_DOUBLE, value.toRawBits(), null)
+    fun addString(key: PropertyKey, value: String) = add(key, ValueType.RLM_TYPE_STRING, 0, value)
+    fun addByteArray(key: PropertyKey, value: ByteArray) =
+        add(key, ValueType.RLM_TYPE_BINARY, 0, value)
+    fun addTimestamp(key: PropertyKey, value: Timestamp) =
+        add(key, ValueType.RLM_TYPE_TIMESTAMP, 0, value)
+    fun addDecimal128(key: PropertyKey, value: Decimal128) =
+        add(key, ValueType.RLM_TYPE_DECIMAL128, 0, value)
+    fun addObjectId(key: PropertyKey, value: ByteArray) =
+        add(key, ValueType.RLM_TYPE_OBJECT_ID, 0, value)
+    fun addUUID(key: PropertyKey, value: ByteArray) = add(key, ValueType.RLM_TYPE_UUID, 0, value)
+
+    fun clear() {
+        objects.fill(null, 0, size)
+        size = 0
+    }
+
+    /**
+     * Creates a transport for the value at [index] in the scope of the [allocator].
+     */
+    @Suppress("ComplexMethod")
+    internal fun toTransport(allocator: MemTrackingAllocator, index: Int): RealmValue =
+        with(allocator) {
+            val primitive = primitives[index]
+            val value = objects[index]
+            when (types[index]) {
+                ValueType.RLM_TYPE_INT -> longTransport(primitive)
+                ValueType.RLM_TYPE_BOOL -> booleanTransport(primitive != 0L)
+                ValueType.RLM_TYPE_FLOAT -> floatTransport(Float.fromBits(primitive.toInt()))
+                ValueType.RLM_TYPE_DOUBLE -> doubleTransport(Double.fromBits(primitive))
+                ValueType.RLM_TYPE_STRING -> stringTransport(value as String)
+                ValueType.RLM_TYPE_BINARY -> byteArrayTransport(value as ByteArray)
+                ValueType.RLM_TYPE_TIMESTAMP -> timestampTransport(value as Timestamp)
+                ValueType.RLM_TYPE_DECIMAL128 -> decimal128Transport(value as Decimal128)
+                ValueType.RLM_TYPE_OBJECT_ID -> objectIdTransport(value as ByteArray)
+                ValueType.RLM_TYPE_UUID -> uuidTransport(value as ByteArray)
+                else -> nullTransport()
+            }
+        }
+
+    private fun add(key: PropertyKey, type: ValueType, primitive: Long, value: Any?) {
+        if (size == keys.size) {
+            grow()
+        }
+        keys[size] = key.key
+        types[size] = type
+        primitives[size] = primitive
+        objects[size] = value
+        size++
+    }
+
+    private fun grow() {
+        val capacity = maxOf(keys.size * 2, DEFAULT_CAPACITY)
+        keys = keys.copyOf(capacity)
+        types = Array(capacity) { if (it < size) types[it] else ValueType.RLM_TYPE_NULL }
+        primitives = primitives.copyOf(capacity)
+        objects = objects.copyOf(capacity)
+    }
+
+    private companion object {
+        const val DEFAULT_CAPACITY = 16
+    }
+}
@@ -34,6 +34,9 @@ interface WebSocketTransport {
      * Create and register a new timer whose handler function will be posted
      * to the event loop when the provided delay expires.
      * @return [CancellableTimer] to be called if the timer is to be cancelled before the delay.
+     *
+     * Not used on JVM, where the timers are kept in a timer wheel of the native layer that only
+     * posts to the event loop when timers expire or have been cancelled.
      */
     fun createTimer(
         delayInMilliseconds: Long,
@@ -133,7 +136,7 @@ interface WebsocketEngine {
 /**
  * Wrapper around Core callback pointer (observer). This will delegate calls for all incoming messages from the remote peer.
  */
-class WebSocketObserver(private val webSocketObserverPointer: RealmWebsocketProviderPointer) {
+class WebSocketObserver(internal val webSocketObserverPointer: RealmWebsocketProviderPointer) {
     /**
      * Communicate the negotiated Sync protocol.
      */
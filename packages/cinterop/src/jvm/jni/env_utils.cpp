@@ -16,19 +16,72 @@
 
 #include "env_utils.h"
 #include "java_class_global_def.hpp"
+#include <atomic>
 #include <stdexcept> // needed for Linux centos7 build
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
 
 static JavaVM *cached_jvm = 0;
 
+// Environment of the current thread. Only cached once obtained, the JNIEnv of a thread stays the
+// same as long as the thread is attached. Only used by `get_env(true)`, as `get_env_or_null` must
+// ask the VM to find out whether it has shut down.
+static thread_local JNIEnv *cached_env = nullptr;
+// Whether the current thread has been attached by us and thus should be detached on exit
+static thread_local bool attached_here = false;
+
+static std::atomic<int64_t> attached_threads(0);
+static std::atomic<int64_t> detached_threads(0);
+
+static void detach_on_thread_exit(void*) {
+    cached_jvm->DetachCurrentThread();
+    cached_env = nullptr;
+    attached_here = false;
+    detached_threads.fetch_add(1, std::memory_order_relaxed);
+}
+
+#if defined(_WIN32)
+// Threads attached by us are detached when this is destroyed on thread exit
+struct AttachedThread {
+    bool attached = false;
+    ~AttachedThread() {
+        if (attached) {
+            detach_on_thread_exit(nullptr);
+        }
+    }
+};
+static thread_local AttachedThread attached_thread;
+#else
+static pthread_key_t detach_key;
+#endif
+
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *jvm, void *reserved) {
     cached_jvm = jvm;
+#if !defined(_WIN32)
+    // The destructor is only run for threads with a non-null value, i.e. threads attached by us
+    pthread_key_create(&detach_key, detach_on_thread_exit);
+#endif
     realm::_impl::JavaClassGlobalDef::initialize(realm::jni_util::get_env());
     return JNI_VERSION_1_2;
 }
 
+// Marks the current thread to be detached when it exits
+static void detach_on_exit(bool detach) {
+    attached_here = detach;
+#if defined(_WIN32)
+    attached_thread.attached = detach;
+#else
+    pthread_setspecific(detach_key, detach ? cached_jvm : nullptr);
+#endif
+}
+
 namespace realm {
     namespace jni_util {
         JNIEnv * get_env(bool attach_if_needed, bool is_daemon_thread, realm::util::Optional<std::string> thread_name) {
+            if (attach_if_needed && cached_env) {
+                return cached_env;
+            }
             JNIEnv *env;
             jint rc = cached_jvm->GetEnv((void **)&env, JNI_VERSION_1_2);
             if (rc == JNI_EDETACHED) {
@@ -53,6 +106,8 @@ namespace realm {
                         ret = cached_jvm->AttachCurrentThread(jenv, &args);
                     }
                     if (ret != JNI_OK) throw std::runtime_error("Could not attach JVM on thread ");
+                    attached_threads.fetch_add(1, std::memory_order_relaxed);
+                    detach_on_exit(true);
                 } else {
                     throw std::runtime_error("current thread not attached");
                 }
@@ -60,15 +115,21 @@ namespace realm {
             if (rc == JNI_EVERSION)
                 throw std::runtime_error("jni version not supported");
 
+            cached_env = env;
             return env;
         }
 
         void detach_current_thread() {
             cached_jvm->DetachCurrentThread();
+            cached_env = nullptr;
+            if (attached_here) {
+                detach_on_exit(false);
+                detached_threads.fetch_add(1, std::memory_order_relaxed);
+            }
         }
 
         JNIEnv * get_env_or_null() {
-            JNIEnv *env;
+            JNIEnv *env = nullptr;
             jint rc = cached_jvm->GetEnv((void **)&env, JNI_VERSION_1_2);
             if (rc == JNI_EDETACHED) {
                 #if defined(__ANDROID__)
@@ -76,13 +137,27 @@ namespace realm {
                 #else
                     void **jenv = (void **) &env;
                 #endif
-                cached_jvm->AttachCurrentThread(jenv, nullptr);
+                if (cached_jvm->AttachCurrentThread(jenv, nullptr) == JNI_OK) {
+                    attached_threads.fetch_add(1, std::memory_order_relaxed);
+                    detach_on_exit(true);
+                    cached_env = env;
+                } else {
+                    env = nullptr;
+                }
             }
             if (rc == JNI_EVERSION)
                 throw std::runtime_error("jni version not supported");
             return env;
         }
 
+        int64_t attached_thread_count() {
+            return attached_threads.load(std::memory_order_relaxed);
+        }
+
+        int64_t detached_thread_count() {
+            return detached_threads.load(std::memory_order_relaxed);
+        }
+
         jmethodID lookup(JNIEnv *jenv, const char *class_name, const char *method_name,
                          const char *signature) {
             jclass localClass = jenv->FindClass(class_name);
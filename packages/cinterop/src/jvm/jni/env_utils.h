@@ -18,6 +18,7 @@
 #define TEST_ENV_UTILS_H
 
 #include <jni.h>
+#include <cstdint>
 #include <cstring>
 #include <string>
 #include <vector>
@@ -37,6 +38,9 @@ namespace realm {
         // to obtain an environment, in which case we assume that the VM has shut down;
         JNIEnv * get_env_or_null();
         void detach_current_thread();
+        // Number of threads attached to and detached from the JVM by us since loading the library
+        int64_t attached_thread_count();
+        int64_t detached_thread_count();
         // TODO Migrate java_method.{hpp,cpp} realm-java or implement similar caching mechanism to
         //  hold global references to classes and look up methods
         jmethodID lookup(JNIEnv *jenv, const char *class_name, const char *method_name,
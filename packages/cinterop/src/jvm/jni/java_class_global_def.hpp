@@ -46,6 +46,7 @@ private:
         : m_java_util_hashmap(env, "java/util/HashMap", false)
         , m_java_lang_int(env, "java/lang/Integer", false)
         , m_java_lang_string(env, "java/lang/String", false)
+        , m_java_nio_byte_buffer(env, "java/nio/ByteBuffer", false)
         , m_kotlin_jvm_functions_function0(env, "kotlin/jvm/functions/Function0", false)
         , m_kotlin_jvm_functions_function1(env, "kotlin/jvm/functions/Function1", false)
         , m_io_realm_kotlin_internal_interop_sync_network_transport(env, "io/realm/kotlin/internal/interop/sync/NetworkTransport", false)
@@ -69,7 +70,9 @@ private:
         , m_io_realm_kotlin_internal_interop_sync_thread_observer(env, "io/realm/kotlin/internal/interop/SyncThreadObserver", false)
         , m_io_realm_kotlin_internal_interop_sync_websocket_transport(env, "io/realm/kotlin/internal/interop/sync/WebSocketTransport", false)
         , m_io_realm_kotlin_internal_interop_sync_websocket_client(env, "io/realm/kotlin/internal/interop/sync/WebSocketClient", false)
+        , m_io_realm_kotlin_internal_interop_sync_byte_buffer_websocket_client(env, "io/realm/kotlin/internal/interop/sync/ByteBufferWebSocketClient", false)
         , m_io_realm_kotlin_internal_interop_notification_callback(env, "io/realm/kotlin/internal/interop/NotificationCallback", false)
+        , m_io_realm_kotlin_internal_interop_notification_multiplexer(env, "io/realm/kotlin/internal/interop/NotificationMultiplexer", false)
         , m_io_realm_kotlin_internal_interop_sync_connection_state(env, "io/realm/kotlin/internal/interop/sync/CoreConnectionState", false)
 
     {
@@ -78,6 +81,7 @@ private:
     jni_util::JavaClass m_java_util_hashmap;
     jni_util::JavaClass m_java_lang_int;
     jni_util::JavaClass m_java_lang_string;
+    jni_util::JavaClass m_java_nio_byte_buffer;
     jni_util::JavaClass m_kotlin_jvm_functions_function0;
     jni_util::JavaClass m_kotlin_jvm_functions_function1;
     jni_util::JavaClass m_io_realm_kotlin_internal_interop_sync_network_transport;
@@ -101,7 +105,9 @@ private:
     jni_util::JavaClass m_io_realm_kotlin_internal_interop_sync_thread_observer;
     jni_util::JavaClass m_io_realm_kotlin_internal_interop_sync_websocket_transport;
     jni_util::JavaClass m_io_realm_kotlin_internal_interop_sync_websocket_client;
+    jni_util::JavaClass m_io_realm_kotlin_internal_interop_sync_byte_buffer_websocket_client;
     jni_util::JavaClass m_io_realm_kotlin_internal_interop_notification_callback;
+    jni_util::JavaClass m_io_realm_kotlin_internal_interop_notification_multiplexer;
     jni_util::JavaClass m_io_realm_kotlin_internal_interop_sync_connection_state;
 
     inline static std::unique_ptr<JavaClassGlobalDef>& instance()
@@ -129,6 +135,11 @@ public:
         return instance()->m_java_util_hashmap;
     }
 
+    inline static const jni_util::JavaClass& java_nio_byte_buffer()
+    {
+        return instance()->m_java_nio_byte_buffer;
+    }
+
     inline static jobject new_int(JNIEnv* env, int32_t value)
     {
         static jni_util::JavaMethod init(env,
@@ -245,6 +256,11 @@ public:
         return instance()->m_io_realm_kotlin_internal_interop_notification_callback;
     }
 
+    inline static const jni_util::JavaClass& notification_multiplexer()
+    {
+        return instance()->m_io_realm_kotlin_internal_interop_notification_multiplexer;
+    }
+
     inline static const jni_util::JavaMethod function0Method(JNIEnv* env) {
         return jni_util::JavaMethod(env, instance()->m_kotlin_jvm_functions_function0, "invoke",
                                     "()Ljava/lang/Object;");
@@ -262,6 +278,10 @@ public:
     inline static const jni_util::JavaClass& sync_websocket_client() {
         return instance()->m_io_realm_kotlin_internal_interop_sync_websocket_client;
     }
+
+    inline static const jni_util::JavaClass& sync_byte_buffer_websocket_client() {
+        return instance()->m_io_realm_kotlin_internal_interop_sync_byte_buffer_websocket_client;
+    }
 };
 
 } // namespace realm
@@ -18,16 +18,154 @@
 #define REALM_UTIL_UTF8_HPP
 
 #include <stdint.h>
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <type_traits>
 
 #include <realm/util/safe_int_ops.hpp>
 #include <realm/string_data.hpp>
 #include <realm/util/features.h>
 #include <realm/utilities.hpp>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define REALM_UTF8_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define REALM_UTF8_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace realm {
 namespace util {
 
+/// Vectorized helpers for runs of ASCII characters, which dominate most strings and can be
+/// transcoded without decoding individual characters. SSE2 and NEON are part of the baseline
+/// instruction sets of x86-64 and arm64 respectively, so the vector code is selected at compile
+/// time; other architectures process 8 bytes at a time with plain 64-bit arithmetic.
+///
+/// All functions only handle whole blocks and return the number of elements processed, which
+/// is a prefix of the input consisting of ASCII characters only. The remaining input must be
+/// processed by the scalar code.
+namespace utf8_ascii {
+
+/// Returns the length of the ASCII prefix of the UTF-8 input.
+inline size_t prefix(const char* in, size_t size) noexcept
+{
+    size_t i = 0;
+#if defined(REALM_UTF8_SSE2)
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        if (_mm_movemask_epi8(v) != 0)
+            break;
+    }
+#elif defined(REALM_UTF8_NEON)
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(in + i));
+        if (vmaxvq_u8(v) >= 0x80)
+            break;
+    }
+#else
+    for (; i + 8 <= size; i += 8) {
+        uint64_t v;
+        std::memcpy(&v, in + i, 8);
+        if ((v & 0x8080808080808080ULL) != 0)
+            break;
+    }
+#endif
+    return i;
+}
+
+/// Returns the length of the ASCII prefix of the UTF-16 input.
+inline size_t prefix(const uint16_t* in, size_t size) noexcept
+{
+    size_t i = 0;
+#if defined(REALM_UTF8_SSE2)
+    const __m128i mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+    for (; i + 8 <= size; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, mask), _mm_setzero_si128())) != 0xFFFF)
+            break;
+    }
+#elif defined(REALM_UTF8_NEON)
+    for (; i + 8 <= size; i += 8) {
+        if (vmaxvq_u16(vld1q_u16(in + i)) >= 0x80)
+            break;
+    }
+#else
+    for (; i + 4 <= size; i += 4) {
+        uint64_t v;
+        std::memcpy(&v, in + i, 8);
+        if ((v & 0xFF80FF80FF80FF80ULL) != 0)
+            break;
+    }
+#endif
+    return i;
+}
+
+/// Widens the ASCII prefix of the UTF-8 input into the UTF-16 output, which must have room for
+/// \a size elements.
+inline size_t to_utf16(const char* in, size_t size, uint16_t* out) noexcept
+{
+    size_t i = 0;
+#if defined(REALM_UTF8_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        if (_mm_movemask_epi8(v) != 0)
+            break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpackhi_epi8(v, zero));
+    }
+#elif defined(REALM_UTF8_NEON)
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(in + i));
+        if (vmaxvq_u8(v) >= 0x80)
+            break;
+        vst1q_u16(out + i, vmovl_u8(vget_low_u8(v)));
+        vst1q_u16(out + i + 8, vmovl_high_u8(v));
+    }
+#else
+    size_t n = prefix(in, size);
+    for (; i < n; ++i)
+        out[i] = uint16_t(static_cast<unsigned char>(in[i]));
+#endif
+    return i;
+}
+
+/// Narrows the ASCII prefix of the UTF-16 input into the UTF-8 output, which must have room for
+/// \a size bytes.
+inline size_t to_utf8(const uint16_t* in, size_t size, char* out) noexcept
+{
+    size_t i = 0;
+#if defined(REALM_UTF8_SSE2)
+    const __m128i mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+    for (; i + 16 <= size; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8));
+        __m128i high = _mm_and_si128(_mm_or_si128(a, b), mask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xFFFF)
+            break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(a, b));
+    }
+#elif defined(REALM_UTF8_NEON)
+    for (; i + 16 <= size; i += 16) {
+        uint16x8_t a = vld1q_u16(in + i);
+        uint16x8_t b = vld1q_u16(in + i + 8);
+        if (vmaxvq_u16(vorrq_u16(a, b)) >= 0x80)
+            break;
+        vst1q_u8(reinterpret_cast<uint8_t*>(out + i), vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+    }
+#else
+    size_t n = prefix(in, size);
+    for (; i < n; ++i)
+        out[i] = static_cast<char>(in[i]);
+#endif
+    return i;
+}
+
+} // namespace utf8_ascii
+
 
 /// Transcode between UTF-8 and UTF-16.
 ///
@@ -35,8 +173,14 @@ namespace util {
 ///
 /// \tparam Traits16 Must define to_int_type() and to_char_type() for
 /// \a Char16.
+///
+/// When \a Char16 is `uint16_t` runs of ASCII characters are transcoded
+/// through the vectorized helpers in `utf8_ascii`, which assumes that
+/// \a Traits16 maps ASCII characters to themselves.
 template <class Char16, class Traits16 = std::char_traits<Char16>>
 struct Utf8x16 {
+    static constexpr bool ascii_fast_path = std::is_same<Char16, uint16_t>::value;
+
     /// Transcode as much as possible of the specified UTF-8 input, to
     /// UTF-16. Returns true if all input characters were transcoded, or
     /// transcoding stopped because the next character did not fit into the
@@ -96,6 +240,14 @@ inline size_t Utf8x16<Char16, Traits16>::to_utf16(const char*& in_begin, const c
         }
         uint_fast16_t v1 = uint_fast16_t(traits8::to_int_type(in[0]));
         if (REALM_LIKELY(v1 < 0x80)) { // One byte
+            if constexpr (ascii_fast_path) {
+                size_t n = utf8_ascii::to_utf16(in, std::min<size_t>(in_end - in, out_end - out), out);
+                if (n != 0) {
+                    in += n;
+                    out += n;
+                    continue;
+                }
+            }
             // UTF-8 layout: 0xxxxxxx
             *out++ = Traits16::to_char_type(v1);
             in += 1;
@@ -208,8 +360,9 @@ inline std::size_t Utf8x16<Char16, Traits16>::find_utf16_buf_size(const char*& i
     while (in != in_end) {
         uint_fast16_t v1 = uint_fast16_t(traits8::to_int_type(in[0]));
         if (REALM_LIKELY(v1 < 0x80)) { // One byte
-            num_out += 1;
-            in += 1;
+            size_t n = std::max<size_t>(utf8_ascii::prefix(in, in_end - in), 1);
+            num_out += n;
+            in += n;
             continue;
         }
         if (REALM_UNLIKELY(v1 < 0xC0)) {
@@ -274,6 +427,14 @@ inline size_t Utf8x16<Char16, Traits16>::to_utf8(const Char16*& in_begin, const
                 error_code = 1;
                 break; // Not enough output buffer space
             }
+            if constexpr (ascii_fast_path) {
+                size_t n = utf8_ascii::to_utf8(in, std::min<size_t>(in_end - in, out_end - out), out);
+                if (n != 0) {
+                    in += n;
+                    out += n;
+                    continue;
+                }
+            }
             // UTF-8 layout: 0xxxxxxx
             *out++ = traits8::to_char_type(traits8_int_type(v1));
             in += 1;
@@ -350,11 +511,15 @@ inline std::size_t Utf8x16<Char16, Traits16>::find_utf8_buf_size(const Char16*&
     while (in != in_end) {
         uint_fast16_t v = uint_fast16_t(Traits16::to_int_type(in[0]));
         if (REALM_LIKELY(v < 0x80)) {
-            if (REALM_UNLIKELY(int_add_with_overflow_detect(num_out, 1))) {
+            size_t n = 1;
+            if constexpr (ascii_fast_path) {
+                n = std::max<size_t>(utf8_ascii::prefix(in, in_end - in), 1);
+            }
+            if (REALM_UNLIKELY(int_add_with_overflow_detect(num_out, n))) {
                 error_code = 1;
                 break; // Avoid overflow
             }
-            in += 1;
+            in += n;
         }
         else if (REALM_LIKELY(v < 0x800)) {
             if (REALM_UNLIKELY(int_add_with_overflow_detect(num_out, 2))) {
@@ -207,6 +207,65 @@ private:
     }
 };
 
+namespace {
+// Per-thread bump allocator for the UTF-8 buffers of JStringAccessors. Accessors only live for
+// the duration of a JNI call, so the arena is rewound as soon as no accessor references it
+// anymore. Strings that are too large, or that don't fit while other accessors are alive, fall back
+// to the heap.
+class StringArena {
+public:
+    static constexpr size_t capacity = 32 * 1024;
+    static constexpr size_t max_allocation = 4 * 1024;
+
+    static StringArena& get()
+    {
+        thread_local StringArena arena;
+        return arena;
+    }
+
+    char* allocate(size_t size)
+    {
+        if (size > max_allocation || capacity - m_used < size) {
+            return nullptr;
+        }
+        if (!m_buffer) {
+            m_buffer.reset(new char[capacity]); // throws
+        }
+        m_last = m_buffer.get() + m_used;
+        m_used += size;
+        ++m_live;
+        return m_last;
+    }
+
+    // Gives back the unused tail of an allocation if it is the most recent one
+    void shrink(const char* data, size_t size) noexcept
+    {
+        if (data == m_last) {
+            m_used = (data - m_buffer.get()) + size;
+        }
+    }
+
+    void retain() noexcept
+    {
+        ++m_live;
+    }
+
+    void release() noexcept
+    {
+        if (--m_live == 0) {
+            m_used = 0;
+            m_last = nullptr;
+        }
+    }
+
+private:
+    std::unique_ptr<char[]> m_buffer;
+    size_t m_used = 0;
+    size_t m_live = 0;
+    const char* m_last = nullptr;
+};
+} // anonymous namespace
+
 JStringAccessor::JStringAccessor(JNIEnv* env, jstring str, bool delete_jstring_ref)
         : m_env(env)
 {
@@ -215,7 +274,8 @@ JStringAccessor::JStringAccessor(JNIEnv* env, jstring str, bool delete_jstring_r
     // bytes) is simply 4 times the number of 16-bit elements in the
     // input. This is guaranteed to be enough. However, to avoid
     // excessive over allocation, this is not done for larger input
-    // strings.
+    // strings. The unused part of the buffer is given back to the
+    // thread's string arena after transcoding.
 
     if (str == NULL) {
         m_is_null = true;
@@ -238,13 +298,25 @@ JStringAccessor::JStringAccessor(JNIEnv* env, jstring str, bool delete_jstring_r
         size_t error_code;
         buf_size = Xcode::find_utf8_buf_size(begin, end, error_code);
     }
-    char* tmp_char_array = new char[buf_size]; // throws
-    m_data.reset(tmp_char_array, std::default_delete<char[]>());
-    {
+    // Reserve room for a terminating zero, which has been part of the buffer since the early days
+    // and thus might be relied upon
+    buf_size += 1;
+
+    StringArena& arena = StringArena::get();
+    char* buffer = arena.allocate(buf_size); // throws
+    if (buffer) {
+        m_in_arena = true;
+    }
+    else {
+        buffer = new char[buf_size]; // throws
+        m_heap_data.reset(buffer, std::default_delete<char[]>());
+    }
+    m_data = buffer;
+    try {
         const jchar* in_begin = chars.data();
         const jchar* in_end = in_begin + chars.size();
-        char* out_begin = m_data.get();
-        char* out_end = m_data.get() + buf_size;
+        char* out_begin = buffer;
+        char* out_end = buffer + buf_size - 1;
         size_t error_code;
         if (!Xcode::to_utf8(in_begin, in_end, out_begin, out_end, error_code)) {
             throw InvalidArgument(
@@ -254,8 +326,56 @@ JStringAccessor::JStringAccessor(JNIEnv* env, jstring str, bool delete_jstring_r
             throw InvalidArgument(
                     string_to_hex("in_begin != in_end when converting to UTF-8", chars.data(), chars.size(), error_code));
         }
-        m_size = out_begin - m_data.get();
-        // FIXME: Does this help on string issues? Or does it only help lldb?
-        std::memset(tmp_char_array + m_size, 0, buf_size - m_size);
+        m_size = out_begin - buffer;
+        buffer[m_size] = 0;
+    }
+    catch (...) {
+        // The destructor is not run for partially constructed objects
+        if (m_in_arena) {
+            arena.release();
+        }
+        throw;
+    }
+    if (m_in_arena) {
+        arena.shrink(buffer, m_size + 1);
+    }
+}
+
+JStringAccessor::JStringAccessor(const JStringAccessor& other)
+        : m_env(other.m_env)
+        , m_is_null(other.m_is_null)
+        , m_data(other.m_data)
+        , m_size(other.m_size)
+        , m_heap_data(other.m_heap_data)
+        , m_in_arena(other.m_in_arena)
+{
+    if (m_in_arena) {
+        StringArena::get().retain();
+    }
+}
+
+JStringAccessor& JStringAccessor::operator=(const JStringAccessor& other)
+{
+    if (this != &other) {
+        if (other.m_in_arena) {
+            StringArena::get().retain();
+        }
+        if (m_in_arena) {
+            StringArena::get().release();
+        }
+        m_env = other.m_env;
+        m_is_null = other.m_is_null;
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_heap_data = other.m_heap_data;
+        m_in_arena = other.m_in_arena;
+    }
+    return *this;
+}
+
+JStringAccessor::~JStringAccessor()
+{
+    if (m_in_arena) {
+        StringArena::get().release();
     }
 }
@@ -32,6 +32,9 @@ class JStringAccessor {
 public:
     JStringAccessor(JNIEnv* env, jstring s) : JStringAccessor(env, s, false) {}; // throws
     JStringAccessor(JNIEnv*, jstring, bool); // throws
+    JStringAccessor(const JStringAccessor&);
+    JStringAccessor& operator=(const JStringAccessor&);
+    ~JStringAccessor();
 
     bool is_null_or_empty() {
         return m_is_null || m_size == 0;
@@ -55,7 +58,7 @@ public:
                             m_size, max_string_size));
         }
         else {
-            return realm::StringData(m_data.get(), m_size);
+            return realm::StringData(m_data, m_size);
         }
     }
 
@@ -64,17 +67,17 @@ public:
         if (m_is_null) {
             return std::string();
         }
-        return std::string(m_data.get(), m_size);
+        return std::string(m_data, m_size);
     }
 
     operator realm_string_t() const noexcept
     {
-        return realm_string_t {m_data.get(), m_size };
+        return realm_string_t {m_data, m_size };
     }
 
     inline const char* data() const noexcept
     {
-        return m_data.get();
+        return m_data;
     };
 
     inline size_t size() const noexcept
@@ -85,8 +88,13 @@ public:
 private:
     JNIEnv* m_env;
     bool m_is_null;
-    std::shared_ptr<char> m_data;
-    std::size_t m_size;
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+    // Owns the buffer of strings that didn't fit into the thread's string arena. Buffers in the
+    // arena are reference counted by the arena itself, so accessors must not leave the thread
+    // that created them.
+    std::shared_ptr<char> m_heap_data;
+    bool m_in_arena = false;
 };
 
 // Accessor for Java object arrays
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.kotlin.internal.interop
+
+import kotlinx.coroutines.CloseableCoroutineDispatcher
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.ExperimentalCoroutinesApi
+import kotlinx.coroutines.asExecutor
+import kotlin.coroutines.CoroutineContext
+
+/**
+ * Dispatcher running its blocks on a native thread driven by an epoll loop, see `EventLoop` in
+ * `realm_api_helpers.cpp`.
+ *
+ * Schedulers created for this dispatcher through [RealmInterop.realm_create_scheduler] perform
+ * their work directly on the loop thread, so notifications of realms bound to it are delivered
+ * without dispatching through Kotlin. Only available on Linux.
+ */
+@OptIn(ExperimentalCoroutinesApi::class)
+class EventLoopDispatcher(name: String) : CloseableCoroutineDispatcher() {
+
+    private val lock = SynchronizableObject()
+    // Blocks still queued on the loop when closing are handed to the IO pool
+    private var loop: Long = realmc.realm_event_loop_new(name, Dispatchers.IO.asExecutor()).also {
+        if (it == 0L) {
+            throw IllegalStateException("Native event loops are only supported on Linux")
+        }
+    }
+
+    override fun dispatch(context: CoroutineContext, block: Runnable) {
+        val dispatched = lock.withLock {
+            if (loop != 0L) {
+                realmc.realm_event_loop_post(loop, block)
+                true
+            } else {
+                false
+            }
+        }
+        // Same as executor based dispatchers, blocks dispatched after closing run on the IO pool
+        if (!dispatched) {
+            Dispatchers.IO.dispatch(context, block)
+        }
+    }
+
+    internal fun createScheduler(): RealmSchedulerPointer = lock.withLock {
+        check(loop != 0L) { "Event loop has been closed" }
+        LongPointerWrapper(realmc.realm_event_loop_scheduler(loop))
+    }
+
+    override fun close() {
+        // Closing waits for the loop thread, so it must not hold the lock that blocks dispatched
+        // from the loop thread might wait on
+        val closed = lock.withLock {
+            loop.also { loop = 0L }
+        }
+        if (closed != 0L) {
+            realmc.realm_event_loop_close(closed)
+        }
+    }
+}
@@ -16,33 +16,38 @@
 
 package io.realm.kotlin.internal.interop
 
-import kotlin.reflect.KMutableProperty0
-
-private fun LongArray.asAccessor(): ArrayAccessor = { index: Int -> this[index].toInt() }
-
-private fun realm_index_range_t.asFromAccessor(): ArrayAccessor = { index: Int ->
-    realmc.indexRangeArray_getitem(this, index).from.toInt()
-}
-
-private fun realm_index_range_t.asToAccessor(): ArrayAccessor = { index: Int ->
-    realmc.indexRangeArray_getitem(this, index).to.toInt()
+// Layout of the flattened change set produced by `realm_collection_changes_get_flattened` in
+// realm_api_helpers.cpp. A header of counts is followed by the indices and then by the ranges,
+// where each move and range is stored as a (from, to) pair. The first header entry holds the
+// cleared/deleted flags of the change set.
+private const val DELETIONS = 1
+private const val INSERTIONS = 2
+private const val MODIFICATIONS = 3
+private const val MOVES = 4
+private const val DELETION_RANGES = 5
+private const val INSERTION_RANGES = 6
+private const val MODIFICATION_RANGES = 7
+private const val HEADER_SIZE = 8
+
+/**
+ * Populates the builder from a change set flattened into a single [IntArray].
+ */
+fun <T, R> CollectionChangeSetBuilder<T, R>.initFromFlattened(changes: IntArray) {
+    var offset = HEADER_SIZE
+    fun indices(count: Int): IntArray =
+        initIndicesArray(count) { changes[offset + it] }.also { offset += count }
+    fun ranges(count: Int): Array<R> =
+        initRangesArray(count, { changes[offset + 2 * it] }, { changes[offset + 2 * it + 1] })
+            .also { offset += 2 * count }
+
+    deletionIndices = indices(changes[DELETIONS])
+    insertionIndices = indices(changes[INSERTIONS])
+    modificationIndices = indices(changes[MODIFICATIONS])
+    modificationIndicesAfter = indices(changes[MODIFICATIONS])
+    movesCount = changes[MOVES]
+    offset += 2 * movesCount
+    deletionRanges = ranges(changes[DELETION_RANGES])
+    insertionRanges = ranges(changes[INSERTION_RANGES])
+    modificationRanges = ranges(changes[MODIFICATION_RANGES])
+    modificationRangesAfter = ranges(changes[MODIFICATION_RANGES])
 }
-
-private fun <T, R> CollectionChangeSetBuilder<T, R>.initIndicesArray(indices: LongArray) =
-    initIndicesArray(indices.size, indices.asAccessor())
-
-private fun <T, R> CollectionChangeSetBuilder<T, R>.initRangesArray(
-    ranges: realm_index_range_t,
-    size: Long
-) = initRangesArray(size.toInt(), ranges.asFromAccessor(), ranges.asToAccessor())
-
-fun <T, R> CollectionChangeSetBuilder<T, R>.initIndicesArray(
-    array: KMutableProperty0<IntArray>,
-    indices: LongArray
-) = array.set(initIndicesArray(indices))
-
-fun <T, R> CollectionChangeSetBuilder<T, R>.initRangesArray(
-    array: KMutableProperty0<Array<R>>,
-    ranges: realm_index_range_t,
-    size: Long
-) = array.set(initRangesArray(ranges, size))
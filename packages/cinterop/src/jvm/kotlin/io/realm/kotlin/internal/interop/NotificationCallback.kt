@@ -21,5 +21,35 @@ package io.realm.kotlin.internal.interop
  * Internal callback used from JNI to notify RealmResults or RealmObject changes.
  */
 interface NotificationCallback {
+    /**
+     * @param pointer pointer to a copy of the changes that is owned by the receiver.
+     */
     fun onChange(pointer: Long)
 }
+
+/**
+ * Internal entry point used from JNI to deliver all notifications triggered by one pass of a
+ * scheduler in a single upcall.
+ */
+object NotificationMultiplexer {
+    /**
+     * Delivers each change to its callback. A failing callback doesn't prevent the remaining
+     * callbacks from being notified; the first failure is rethrown once all callbacks have run.
+     */
+    @JvmStatic
+    fun onChanges(callbacks: Array<NotificationCallback>, pointers: LongArray) {
+        var failure: Throwable? = null
+        for (i in callbacks.indices) {
+            try {
+                callbacks[i].onChange(pointers[i])
+            } catch (e: Throwable) {
+                if (failure == null) {
+                    failure = e
+                } else {
+                    failure.addSuppressed(e)
+                }
+            }
+        }
+        failure?.let { throw it }
+    }
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.kotlin.internal.interop
+
+import org.mongodb.kbson.Decimal128
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Thread local direct byte buffers used to receive values packed by the `PackedValueWriter` in
+ * `realm_api_helpers.cpp`. See that class for a description of the layout.
+ */
+internal object PackedValueBuffer {
+    private const val INITIAL_CAPACITY = 4096
+
+    // Upper bound of a record for a property value excluding any variable length payload; the
+    // property key, the header and up to 16 bytes of fixed size payload.
+    private const val MAX_FIXED_RECORD_SIZE = 32
+
+    private val buffers: ThreadLocal<ByteBuffer> = ThreadLocal.withInitial {
+        allocate(INITIAL_CAPACITY)
+    }
+
+    // Separate buffers for writing as values might be packed while a read buffer is still in use
+    private val writeBuffers: ThreadLocal<ByteBuffer> = ThreadLocal.withInitial {
+        allocate(INITIAL_CAPACITY)
+    }
+
+    private val valueTypes: Map<Int, ValueType> = ValueType.values().associateBy { it.nativeValue }
+
+    /**
+     * Fills the calling thread's buffer through [block], which must return the number of bytes
+     * needed to hold the packed values. If the buffer is too small, it is replaced by a larger
+     * one and [block] is invoked again.
+     *
+     * The returned buffer is only valid until the next call on the same thread.
+     */
+    fun fill(block: (ByteBuffer) -> Long): ByteBuffer {
+        var buffer = buffers.get()
+        var size = block(buffer)
+        if (size > buffer.capacity()) {
+            buffer = allocate(size.toInt().takeHighestOneBit() shl 1)
+            buffers.set(buffer)
+            size = block(buffer)
+        }
+        buffer.clear()
+        buffer.limit(size.toInt())
+        return buffer
+    }
+
+    /**
+     * Packs the property keys and values of [row] into the calling thread's write buffer. The
+     * position of the returned buffer marks the end of the packed data.
+     *
+     * The returned buffer is only valid until the next call on the same thread.
+     */
+    @Suppress("ComplexMethod")
+    fun pack(row: RealmValueRowBuilder): ByteBuffer {
+        var buffer = writeBuffers.get()
+        buffer.clear()
+        for (i in 0 until row.size) {
+            val type = row.types[i]
+            val primitive = row.primitives[i]
+            val value = row.objects[i]
+            val payload: ByteArray? = when (type) {
+                ValueType.RLM_TYPE_STRING -> (value as String).encodeToUtf8()
+                ValueType.RLM_TYPE_BINARY -> value as ByteArray
+                else -> null
+            }
+            val required = MAX_FIXED_RECORD_SIZE + (payload?.size ?: 0)
+            if (buffer.remaining() < required) {
+                buffer = grow(buffer, buffer.position() + required)
+                writeBuffers.set(buffer)
+            }
+            buffer.putLong(row.keys[i])
+            buffer.putInt(type.nativeValue)
+            buffer.putInt(payload?.size ?: 0)
+            when (type) {
+                ValueType.RLM_TYPE_INT,
+                ValueType.RLM_TYPE_BOOL,
+                ValueType.RLM_TYPE_DOUBLE -> buffer.putLong(primitive)
+                ValueType.RLM_TYPE_FLOAT -> buffer.putInt(primitive.toInt()).skipPadding()
+                ValueType.RLM_TYPE_STRING,
+                ValueType.RLM_TYPE_BINARY -> buffer.put(payload!!).skipPadding()
+                ValueType.RLM_TYPE_TIMESTAMP -> (value as Timestamp).let {
+                    buffer.putLong(it.seconds).putInt(it.nanoSeconds).skipPadding()
+                }
+                ValueType.RLM_TYPE_DECIMAL128 -> (value as Decimal128).let {
+                    buffer.putLong(it.low.toLong()).putLong(it.high.toLong())
+                }
+                ValueType.RLM_TYPE_OBJECT_ID,
+                ValueType.RLM_TYPE_UUID -> buffer.put(value as ByteArray).skipPadding()
+                else -> Unit
+            }
+        }
+        return buffer
+    }
+
+    // Rejects invalid surrogates like strings passed through `JStringAccessor` instead of replacing
+    // them
+    private fun String.encodeToUtf8(): ByteArray = try {
+        encodeToByteArray(0, length, throwOnInvalidSequence = true)
+    } catch (e: CharacterCodingException) {
+        throw IllegalArgumentException("Failure when converting to UTF-8: Invalid surrogate pair", e)
+    }
+
+    fun valueType(nativeValue: Int): ValueType =
+        valueTypes[nativeValue] ?: error("Unknown value type: $nativeValue")
+
+    private fun grow(buffer: ByteBuffer, minimumCapacity: Int): ByteBuffer =
+        allocate(minimumCapacity.takeHighestOneBit() shl 1).also {
+            buffer.flip()
+            it.put(buffer)
+        }
+
+    private fun allocate(capacity: Int): ByteBuffer =
+        ByteBuffer.allocateDirect(capacity).order(ByteOrder.nativeOrder())
+}
+
+/**
+ * Decodes the next packed value of the buffer into the [index] of the [row].
+ */
+@Suppress("ComplexMethod")
+internal fun ByteBuffer.readPackedValue(row: RealmValueRow, index: Int) {
+    val type = PackedValueBuffer.valueType(int)
+    val size = int
+    val value: Any? = when (type) {
+        ValueType.RLM_TYPE_INT -> long
+        ValueType.RLM_TYPE_BOOL -> long != 0L
+        ValueType.RLM_TYPE_STRING -> String(readBytes(size), Charsets.UTF_8)
+        ValueType.RLM_TYPE_BINARY -> readBytes(size)
+        ValueType.RLM_TYPE_TIMESTAMP -> TimestampImpl(long, int).also { skipPadding() }
+        ValueType.RLM_TYPE_FLOAT -> float.also { skipPadding() }
+        ValueType.RLM_TYPE_DOUBLE -> double
+        ValueType.RLM_TYPE_DECIMAL128 -> ulongArrayOf(long.toULong(), long.toULong())
+        ValueType.RLM_TYPE_OBJECT_ID -> readBytes(OBJECT_ID_BYTES_SIZE)
+        ValueType.RLM_TYPE_UUID -> readBytes(UUID_BYTES_SIZE)
+        ValueType.RLM_TYPE_LINK -> Link(ClassKey(long), long)
+        else -> null
+    }
+    row[index, type] = value
+}
+
+private fun ByteBuffer.readBytes(size: Int): ByteArray =
+    ByteArray(size).also {
+        get(it)
+        skipPadding()
+    }
+
+private fun ByteBuffer.skipPadding(): ByteBuffer =
+    position((position() + 7) and 7.inv()) as ByteBuffer
@@ -19,6 +19,7 @@ package io.realm.kotlin.internal.interop
 import io.realm.kotlin.internal.interop.Constants.ENCRYPTION_KEY_LENGTH
 import io.realm.kotlin.internal.interop.sync.ApiKeyWrapper
 import io.realm.kotlin.internal.interop.sync.AuthProvider
+import io.realm.kotlin.internal.interop.sync.ByteBufferWebSocketClient
 import io.realm.kotlin.internal.interop.sync.CoreConnectionState
 import io.realm.kotlin.internal.interop.sync.CoreSubscriptionSetState
 import io.realm.kotlin.internal.interop.sync.CoreSyncSessionState
@@ -36,6 +37,7 @@ import kotlinx.coroutines.CoroutineDispatcher
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.launch
 import org.mongodb.kbson.ObjectId
+import java.nio.ByteBuffer
 
 // FIXME API-CLEANUP Rename io.realm.interop. to something with platform?
 //  https://github.com/realm/realm-kotlin/issues/56
@@ -220,7 +222,62 @@ actual object RealmInterop {
         LongPointerWrapper(realmc.realm_create_generic_scheduler())
 
     actual fun realm_create_scheduler(dispatcher: CoroutineDispatcher): RealmSchedulerPointer =
-        LongPointerWrapper(realmc.realm_create_scheduler(JVMScheduler(dispatcher)))
+        when (dispatcher) {
+            // Work is performed directly on the loop thread without going through the dispatcher
+            is EventLoopDispatcher -> dispatcher.createScheduler()
+            else -> LongPointerWrapper(realmc.realm_create_scheduler(JVMScheduler(dispatcher)))
+        }
+
+    /**
+     * Returns the number of scheduler notifications that were coalesced into an already pending
+     * dispatch instead of dispatching a new one. Only available on JVM.
+     */
+    fun realm_scheduler_coalesced_notifications(): Long =
+        realmc.realm_scheduler_coalesced_notifications()
+
+    /**
+     * Enables or disables batched delivery of notifications. When enabled, all notifications
+     * triggered by one pass of a scheduler are delivered through a single JNI upcall. Only
+     * available on JVM.
+     */
+    fun realm_set_batched_notifications(enabled: Boolean) {
+        realmc.realm_set_batched_notifications(enabled)
+    }
+
+    /**
+     * Returns the number of changes that were merged into a pending change for a
+     * [CoalescingCallback] instead of being delivered. Only available on JVM.
+     */
+    fun realm_merged_notifications(): Long = realmc.realm_merged_notifications()
+
+    /**
+     * Returns the number of native threads attached to and detached from the JVM. Threads
+     * attached by the native layer are detached when they exit, so the difference is the number
+     * of currently attached threads. Only available on JVM.
+     */
+    fun realm_get_jni_thread_stats(): JniThreadStats =
+        realmc.realm_jni_thread_stats().let { JniThreadStats(attached = it[0], detached = it[1]) }
+
+    /**
+     * Returns the latencies of notifications from the commit of a write transaction to entering the
+     * notification callbacks. Only commits performed in this process are tracked and only
+     * notifications delivered through dispatcher based schedulers are attributed to them. Only
+     * available on JVM.
+     */
+    fun realm_get_notification_latency_stats(): NotificationLatencyStats {
+        val stats = realmc.realm_notification_latency_stats()
+        val size = LatencySummary.SIZE
+        val registrations = (4 * size until stats.size step size + 1).associate { offset ->
+            stats[offset] to LatencySummary.of(stats, offset + 1)
+        }
+        return NotificationLatencyStats(
+            commitToNotify = LatencySummary.of(stats, 0),
+            notifyToDispatch = LatencySummary.of(stats, size),
+            dispatchToCallback = LatencySummary.of(stats, 2 * size),
+            commitToCallback = LatencySummary.of(stats, 3 * size),
+            registrations = registrations,
+        )
+    }
 
     actual fun realm_open(
         config: RealmConfigurationPointer,
@@ -235,6 +292,7 @@ actual object RealmInterop {
 
         realmc.realm_config_set_scheduler(config.cptr(), scheduler.cptr())
         val realmPtr = LongPointerWrapper<LiveRealmT>(realmc.realm_open(config.cptr()))
+        realmc.realm_scheduler_track_commits(scheduler.cptr(), realmPtr.cptr())
 
         // Ensure that we can read version information, etc.
         realm_begin_read(realmPtr)
@@ -396,7 +454,7 @@ actual object RealmInterop {
     }
 
     actual fun realm_commit(realm: LiveRealmPointer) {
-        realmc.realm_commit(realm.cptr())
+        realmc.realm_commit_tracked(realm.cptr())
     }
 
     actual fun realm_rollback(realm: LiveRealmPointer) {
@@ -489,6 +547,38 @@ actual object RealmInterop {
         return RealmValue(struct)
     }
 
+    actual fun realm_get_values(obj: RealmObjectPointer, keys: LongArray): RealmValueRow {
+        val buffer = PackedValueBuffer.fill { realmc.realm_get_values_packed(obj.cptr(), keys, it) }
+        return RealmValueRow(keys.size).also { row ->
+            for (i in keys.indices) {
+                buffer.readPackedValue(row, i)
+            }
+        }
+    }
+
+    /**
+     * Returns a read-only view of the UTF-8 encoded bytes of a string property directly in the
+     * Realm file, or `null` if the value is `null`. The view is only valid as long as the version
+     * of the object is kept alive. Only available on JVM as it relies on direct byte buffers.
+     */
+    fun realm_get_string_view(obj: RealmObjectPointer, key: PropertyKey): ByteBuffer? =
+        (realmc.realm_get_string_view(obj.cptr(), key.key) as ByteBuffer?)?.asReadOnlyBuffer()
+
+    actual fun realm_set_values(
+        obj: RealmObjectPointer,
+        values: RealmValueRowBuilder,
+        isDefault: Boolean
+    ) {
+        val buffer = PackedValueBuffer.pack(values)
+        realmc.realm_set_values_packed(
+            obj.cptr(),
+            values.size.toLong(),
+            buffer,
+            buffer.position().toLong(),
+            isDefault
+        )
+    }
+
     actual fun realm_set_value(
         obj: RealmObjectPointer,
         key: PropertyKey,
@@ -879,108 +969,121 @@ actual object RealmInterop {
     }
 
     actual fun realm_create_key_paths_array(realm: RealmPointer, clazz: ClassKey, keyPaths: List<String>): RealmKeyPathArrayPointer {
-        val ptr = realmc.realm_create_key_path_array(realm.cptr(), clazz.key, keyPaths.size.toLong(), keyPaths.toTypedArray())
+        // Resolved key paths are shared natively, so the pointer is only understood by the
+        // notification registrations of this object
+        val ptr = realmc.realm_key_path_array_cached(realm.cptr(), clazz.key, keyPaths.size.toLong(), keyPaths.toTypedArray())
         return LongPointerWrapper(ptr)
     }
 
+    /**
+     * Returns whether two key path arrays created by [realm_create_key_paths_array] share the same
+     * resolved key paths. Only available on JVM.
+     */
+    fun realm_key_path_arrays_shared_for_testing(
+        keyPaths: RealmKeyPathArrayPointer,
+        other: RealmKeyPathArrayPointer
+    ): Boolean = realmc.realm_key_path_arrays_shared_for_testing(keyPaths.cptr(), other.cptr())
+
     actual fun realm_object_add_notification_callback(
         obj: RealmObjectPointer,
         keyPaths: RealmKeyPathArrayPointer?,
         callback: Callback<RealmChangesPointer>
-    ): RealmNotificationTokenPointer {
-
-        return LongPointerWrapper(
+    ): RealmNotificationTokenPointer =
+        registerNotificationCallback(callback) { notificationCallback, policy, subscription ->
             realmc.register_notification_cb(
                 obj.cptr(),
                 CollectionType.RLM_COLLECTION_TYPE_NONE.nativeValue,
                 keyPaths?.cptr() ?: NULL_POINTER_VALUE,
-                object : NotificationCallback {
-                    override fun onChange(pointer: Long) {
-                        callback.onChange(LongPointerWrapper(realmc.realm_clone(pointer), true))
-                    }
-                }
-            ),
-            managed = false
-        )
-    }
+                notificationCallback,
+                policy,
+                subscription
+            )
+        }
 
     actual fun realm_results_add_notification_callback(
         results: RealmResultsPointer,
         keyPaths: RealmKeyPathArrayPointer?,
         callback: Callback<RealmChangesPointer>
-    ): RealmNotificationTokenPointer {
-        return LongPointerWrapper(
+    ): RealmNotificationTokenPointer =
+        registerNotificationCallback(callback) { notificationCallback, policy, subscription ->
             realmc.register_results_notification_cb(
                 results.cptr(),
                 keyPaths?.cptr() ?: NULL_POINTER_VALUE,
-                object : NotificationCallback {
-                    override fun onChange(pointer: Long) {
-                        callback.onChange(LongPointerWrapper(realmc.realm_clone(pointer), true))
-                    }
-                }
-            ),
-            managed = false
-        )
-    }
+                notificationCallback,
+                policy,
+                subscription
+            )
+        }
 
     actual fun realm_list_add_notification_callback(
         list: RealmListPointer,
         keyPaths: RealmKeyPathArrayPointer?,
         callback: Callback<RealmChangesPointer>
-    ): RealmNotificationTokenPointer {
-        return LongPointerWrapper(
+    ): RealmNotificationTokenPointer =
+        registerNotificationCallback(callback) { notificationCallback, policy, subscription ->
             realmc.register_notification_cb(
                 list.cptr(),
                 CollectionType.RLM_COLLECTION_TYPE_LIST.nativeValue,
                 keyPaths?.cptr() ?: NULL_POINTER_VALUE,
-                object : NotificationCallback {
-                    override fun onChange(pointer: Long) {
-                        callback.onChange(LongPointerWrapper(realmc.realm_clone(pointer), true))
-                    }
-                }
-            ),
-            managed = false
-        )
-    }
+                notificationCallback,
+                policy,
+                subscription
+            )
+        }
 
     actual fun realm_set_add_notification_callback(
         set: RealmSetPointer,
         keyPaths: RealmKeyPathArrayPointer?,
         callback: Callback<RealmChangesPointer>
-    ): RealmNotificationTokenPointer {
-        return LongPointerWrapper(
+    ): RealmNotificationTokenPointer =
+        registerNotificationCallback(callback) { notificationCallback, policy, subscription ->
             realmc.register_notification_cb(
                 set.cptr(),
                 CollectionType.RLM_COLLECTION_TYPE_SET.nativeValue,
                 keyPaths?.cptr() ?: NULL_POINTER_VALUE,
-                object : NotificationCallback {
-                    override fun onChange(pointer: Long) {
-                        callback.onChange(LongPointerWrapper(realmc.realm_clone(pointer), true))
-                    }
-                }
-            ),
-            managed = false
-        )
-    }
+                notificationCallback,
+                policy,
+                subscription
+            )
+        }
 
     actual fun realm_dictionary_add_notification_callback(
         map: RealmMapPointer,
         keyPaths: RealmKeyPathArrayPointer?,
         callback: Callback<RealmChangesPointer>
-    ): RealmNotificationTokenPointer {
-        return LongPointerWrapper(
+    ): RealmNotificationTokenPointer =
+        registerNotificationCallback(callback) { notificationCallback, policy, subscription ->
             realmc.register_notification_cb(
                 map.cptr(),
                 CollectionType.RLM_COLLECTION_TYPE_DICTIONARY.nativeValue,
                 keyPaths?.cptr() ?: NULL_POINTER_VALUE,
-                object : NotificationCallback {
-                    override fun onChange(pointer: Long) {
-                        callback.onChange(LongPointerWrapper(realmc.realm_clone(pointer), true))
-                    }
+                notificationCallback,
+                policy,
+                subscription
+            )
+        }
+
+    // Changes of a CoalescingCallback are merged natively until it signals that it is ready for
+    // the next change
+    private fun registerNotificationCallback(
+        callback: Callback<RealmChangesPointer>,
+        register: (NotificationCallback, Int, LongArray) -> Long
+    ): RealmNotificationTokenPointer {
+        val subscription = LongArray(1)
+        val policy = if (callback is CoalescingCallback) NOTIFICATION_POLICY_MERGE else NOTIFICATION_POLICY_DELIVER_ALL
+        val token = register(
+            object : NotificationCallback {
+                override fun onChange(pointer: Long) {
+                    callback.onChange(LongPointerWrapper(pointer, true))
                 }
-            ),
-            managed = false
+            },
+            policy,
+            subscription
         )
+        if (callback is CoalescingCallback) {
+            callback.onRegistered { realmc.realm_notification_ready(subscription[0]) }
+        }
+        return LongPointerWrapper(token, managed = false)
     }
 
     actual fun realm_object_changes_get_modified_properties(change: RealmChangesPointer): List<PropertyKey> {
@@ -991,111 +1094,11 @@ actual object RealmInterop {
         return keys.map { PropertyKey(it) }
     }
 
-    private fun initIndicesArray(size: LongArray): LongArray = LongArray(size[0].toInt())
-    @Suppress("UnusedPrivateMember")
-    private fun initRangeArray(size: LongArray): Array<LongArray> = Array(size[0].toInt()) { LongArray(2) }
-
-    actual fun <T, R> realm_collection_changes_get_indices(change: RealmChangesPointer, builder: CollectionChangeSetBuilder<T, R>) {
-        val insertionCount = LongArray(1)
-        val deletionCount = LongArray(1)
-        val modificationCount = LongArray(1)
-        val movesCount = LongArray(1)
-        // Not exposed in SDK yet, but could be used to provide optimized notifications when
-        // collections are cleared.
-        //  https://github.com/realm/realm-kotlin/issues/1498
-        val collectionWasCleared = BooleanArray(1)
-        val collectionWasDeleted = BooleanArray(1)
-
-        realmc.realm_collection_changes_get_num_changes(
-            change.cptr(),
-            deletionCount,
-            insertionCount,
-            modificationCount,
-            movesCount,
-            collectionWasCleared,
-            collectionWasDeleted,
-        )
-
-        val insertionIndices: LongArray = initIndicesArray(insertionCount)
-        val modificationIndices: LongArray = initIndicesArray(modificationCount)
-        val modificationIndicesAfter: LongArray = initIndicesArray(modificationCount)
-        val deletionIndices: LongArray = initIndicesArray(deletionCount)
-        val moves: realm_collection_move_t = realmc.new_collectionMoveArray(movesCount[0].toInt())
-
-        realmc.realm_collection_changes_get_changes(
-            change.cptr(),
-            deletionIndices,
-            deletionCount[0],
-            insertionIndices,
-            insertionCount[0],
-            modificationIndices,
-            modificationCount[0],
-            modificationIndicesAfter,
-            modificationCount[0],
-            moves,
-            movesCount[0]
-        )
-
-        builder.initIndicesArray(builder::insertionIndices, insertionIndices)
-        builder.initIndicesArray(builder::deletionIndices, deletionIndices)
-        builder.initIndicesArray(builder::modificationIndices, modificationIndices)
-        builder.initIndicesArray(builder::modificationIndicesAfter, modificationIndicesAfter)
-        builder.movesCount = movesCount[0].toInt()
-
-        realmc.delete_collectionMoveArray(moves)
-    }
-
-    actual fun <T, R> realm_collection_changes_get_ranges(
+    actual fun <T, R> realm_collection_changes_get_change_set(
         change: RealmChangesPointer,
         builder: CollectionChangeSetBuilder<T, R>
     ) {
-        val insertRangesCount = LongArray(1)
-        val deleteRangesCount = LongArray(1)
-        val modificationRangesCount = LongArray(1)
-        val movesCount = LongArray(1)
-
-        realmc.realm_collection_changes_get_num_ranges(
-            change.cptr(),
-            deleteRangesCount,
-            insertRangesCount,
-            modificationRangesCount,
-            movesCount
-        )
-
-        val insertionRanges: realm_index_range_t =
-            realmc.new_indexRangeArray(insertRangesCount[0].toInt())
-        val modificationRanges: realm_index_range_t =
-            realmc.new_indexRangeArray(modificationRangesCount[0].toInt())
-        val modificationRangesAfter: realm_index_range_t =
-            realmc.new_indexRangeArray(modificationRangesCount[0].toInt())
-        val deletionRanges: realm_index_range_t =
-            realmc.new_indexRangeArray(deleteRangesCount[0].toInt())
-        val moves: realm_collection_move_t = realmc.new_collectionMoveArray(movesCount[0].toInt())
-
-        realmc.realm_collection_changes_get_ranges(
-            change.cptr(),
-            deletionRanges,
-            deleteRangesCount[0],
-            insertionRanges,
-            insertRangesCount[0],
-            modificationRanges,
-            modificationRangesCount[0],
-            modificationRangesAfter,
-            modificationRangesCount[0],
-            moves,
-            movesCount[0]
-        )
-
-        builder.initRangesArray(builder::deletionRanges, deletionRanges, deleteRangesCount[0])
-        builder.initRangesArray(builder::insertionRanges, insertionRanges, insertRangesCount[0])
-        builder.initRangesArray(builder::modificationRanges, modificationRanges, modificationRangesCount[0])
-        builder.initRangesArray(builder::modificationRangesAfter, modificationRangesAfter, modificationRangesCount[0])
-
-        realmc.delete_indexRangeArray(insertionRanges)
-        realmc.delete_indexRangeArray(modificationRanges)
-        realmc.delete_indexRangeArray(modificationRangesAfter)
-        realmc.delete_indexRangeArray(deletionRanges)
-        realmc.delete_collectionMoveArray(moves)
+        builder.initFromFlattened(realmc.realm_collection_changes_get_flattened(change.cptr()))
     }
 
     actual fun <R> realm_dictionary_get_changes(
@@ -1132,24 +1135,21 @@ actual object RealmInterop {
             collectionWasCleared,
         )
 
-        // TODO optimize - integrate within mem allocator?
-        // Get keys and release array of structs
-        val deletedKeys = (0 until deletions[0]).map {
-            realmc.valueArray_getitem(deletionStructs, it.toInt()).string
-        }
-        val insertedKeys = (0 until insertions[0]).map {
-            realmc.valueArray_getitem(insertionStructs, it.toInt()).string
-        }
-        val modifiedKeys = (0 until modifications[0]).map {
-            realmc.valueArray_getitem(modificationStructs, it.toInt()).string
-        }
+        // Get keys natively, as copies of the structs handed out by `valueArray_getitem` are not
+        // freed by finalization, and release array of structs
+        @Suppress("UNCHECKED_CAST")
+        val deletedKeys = realmc.realm_value_array_get_strings(deletionStructs, deletions[0]) as Array<String>
+        @Suppress("UNCHECKED_CAST")
+        val insertedKeys = realmc.realm_value_array_get_strings(insertionStructs, insertions[0]) as Array<String>
+        @Suppress("UNCHECKED_CAST")
+        val modifiedKeys = realmc.realm_value_array_get_strings(modificationStructs, modifications[0]) as Array<String>
         realmc.delete_valueArray(deletionStructs)
         realmc.delete_valueArray(insertionStructs)
         realmc.delete_valueArray(modificationStructs)
 
-        builder.initDeletions(deletedKeys.toTypedArray())
-        builder.initInsertions(insertedKeys.toTypedArray())
-        builder.initModifications(modifiedKeys.toTypedArray())
+        builder.initDeletions(deletedKeys)
+        builder.initInsertions(insertedKeys)
+        builder.initModifications(modifiedKeys)
     }
 
     actual fun realm_app_get(
@@ -1853,8 +1853,8 @@ actual object RealmInterop {
         )
     }
 
-    actual fun realm_query_find_first(query: RealmQueryPointer): Link? {
-        val value = realm_value_t()
+    actual fun realm_query_find_first(query: RealmQueryPointer): Link? = getterScope {
+        val value = allocRealmValueT()
         val found = booleanArrayOf(false)
         realmc.realm_query_find_first(query.cptr(), value, found)
         if (!found[0]) {
@@ -1863,7 +1863,7 @@ actual object RealmInterop {
         if (value.type != realm_value_type_e.RLM_TYPE_LINK) {
             error("Query did not return link but ${value.type}")
         }
-        return value.asLink()
+        value.asLink()
     }
 
     actual fun realm_query_find_all(query: RealmQueryPointer): RealmResultsPointer {
@@ -1944,7 +1944,6 @@ actual object RealmInterop {
         return RealmValue(struct)
     }
 
-    // TODO OPTIMIZE Getting a range
     actual fun MemAllocator.realm_results_get(
         results: RealmResultsPointer,
         index: Long
@@ -1954,6 +1953,57 @@ actual object RealmInterop {
         return RealmValue(value)
     }
 
+    actual fun realm_results_get_range(
+        results: RealmResultsPointer,
+        from: Long,
+        count: Int
+    ): RealmValueRow {
+        val buffer = PackedValueBuffer.fill {
+            realmc.realm_results_get_range(results.cptr(), from, count.toLong(), it)
+        }
+        return RealmValueRow(count).also { row ->
+            for (i in 0 until count) {
+                buffer.readPackedValue(row, i)
+            }
+        }
+    }
+
+    actual fun realm_results_get_column(
+        results: RealmResultsPointer,
+        key: PropertyKey,
+        values: LongArray,
+        nulls: ByteArray
+    ) {
+        realmc.realm_results_get_long_column(results.cptr(), key.key, values, nulls)
+    }
+
+    actual fun realm_results_get_column(
+        results: RealmResultsPointer,
+        key: PropertyKey,
+        values: DoubleArray,
+        nulls: ByteArray
+    ) {
+        realmc.realm_results_get_double_column(results.cptr(), key.key, values, nulls)
+    }
+
+    actual fun realm_results_get_column(
+        results: RealmResultsPointer,
+        key: PropertyKey,
+        values: FloatArray,
+        nulls: ByteArray
+    ) {
+        realmc.realm_results_get_float_column(results.cptr(), key.key, values, nulls)
+    }
+
+    actual fun realm_results_get_column(
+        results: RealmResultsPointer,
+        key: PropertyKey,
+        values: BooleanArray,
+        nulls: ByteArray
+    ) {
+        realmc.realm_results_get_boolean_column(results.cptr(), key.key, values, nulls)
+    }
+
     actual fun realm_results_get_list(results: RealmResultsPointer, index: Long): RealmListPointer =
         LongPointerWrapper(realmc.realm_results_get_list(results.cptr(), index))
 
@@ -2177,6 +2227,14 @@ actual object RealmInterop {
         realmc.realm_sync_websocket_callback_complete(cancelled, nativePointer.cptr(), status.nativeValue, reason)
     }
 
+    /**
+     * Completes a write of a Frame sent through [ByteBufferWebSocketClient.send]. Only available
+     * on JVM.
+     */
+    fun realm_sync_socket_write_complete(writeId: Long, cancelled: Boolean) {
+        realmc.realm_sync_websocket_write_complete(writeId, cancelled)
+    }
+
     actual fun realm_sync_socket_websocket_connected(nativePointer: RealmWebsocketProviderPointer, protocol: String) {
         realmc.realm_sync_websocket_connected(nativePointer.cptr(), protocol)
     }
@@ -2192,6 +2250,24 @@ actual object RealmInterop {
         return realmc.realm_sync_websocket_message(nativePointer.cptr(), data, data.size.toLong())
     }
 
+    /**
+     * Forwards the remaining bytes of a direct [data] buffer to Core without copying them. Core
+     * reads the message in place, so the buffer can be reused as soon as this returns. The
+     * position of the buffer is not changed. Only available on JVM.
+     */
+    fun realm_sync_socket_websocket_message(
+        nativePointer: RealmWebsocketProviderPointer,
+        data: ByteBuffer
+    ): Boolean {
+        require(data.isDirect) { "Message must be a direct buffer" }
+        return realmc.realm_sync_websocket_message_direct(
+            nativePointer.cptr(),
+            data,
+            data.position().toLong(),
+            data.remaining().toLong()
+        )
+    }
+
     actual fun realm_sync_socket_websocket_closed(nativePointer: RealmWebsocketProviderPointer, wasClean: Boolean, errorCode: WebsocketErrorCode, reason: String) {
         realmc.realm_sync_websocket_closed(nativePointer.cptr(), wasClean, errorCode.nativeValue, reason)
     }
@@ -2316,16 +2392,78 @@ fun ObjectId.asRealmObjectIdT(): realm_object_id_t {
     }
 }
 
+// Must match NotificationPolicy in realm_api_helpers.cpp
+private const val NOTIFICATION_POLICY_DELIVER_ALL = 0
+private const val NOTIFICATION_POLICY_MERGE = 1
+
+/**
+ * Counters of threads attached to the JVM by the native layer, see
+ * [RealmInterop.realm_get_jni_thread_stats].
+ */
+data class JniThreadStats(val attached: Long, val detached: Long)
+
+/**
+ * Summary of a latency histogram. All durations are in nanoseconds. Percentiles are reported as
+ * the upper bound of their histogram bucket and are accurate to within 12.5%.
+ */
+data class LatencySummary(
+    val count: Long,
+    val min: Long,
+    val max: Long,
+    val mean: Long,
+    val p50: Long,
+    val p90: Long,
+    val p99: Long,
+    val p999: Long,
+) {
+    internal companion object {
+        const val SIZE = 8
+
+        fun of(values: LongArray, offset: Int) = LatencySummary(
+            values[offset],
+            values[offset + 1],
+            values[offset + 2],
+            values[offset + 3],
+            values[offset + 4],
+            values[offset + 5],
+            values[offset + 6],
+            values[offset + 7],
+        )
+    }
+}
+
+/**
+ * Latencies of notifications triggered by commits, see
+ * [RealmInterop.realm_get_notification_latency_stats].
+ *
+ * @param commitToNotify from a commit to the scheduler of a realm being notified about it.
+ * @param notifyToDispatch from a scheduler being notified to the work being performed on its
+ * dispatcher.
+ * @param dispatchToCallback from the work being performed to entering a notification callback.
+ * @param commitToCallback from a commit to entering a notification callback.
+ * @param registrations commit to callback latencies of each active registration, keyed by an
+ * opaque id that is stable for the lifetime of the registration.
+ */
+data class NotificationLatencyStats(
+    val commitToNotify: LatencySummary,
+    val notifyToDispatch: LatencySummary,
+    val dispatchToCallback: LatencySummary,
+    val commitToCallback: LatencySummary,
+    val registrations: Map<Long, LatencySummary>,
+)
+
 private class JVMScheduler(dispatcher: CoroutineDispatcher) {
     val scope: CoroutineScope = CoroutineScope(dispatcher)
     val lock = SynchronizableObject()
     var cancelled = false
 
-    fun notifyCore(schedulerPointer: Long) {
+    // Only invoked when no dispatch is pending, the native scheduler then drains all work queues
+    // notified until the dispatched block runs.
+    fun notifyCore(nativeScheduler: Long) {
         scope.launch {
             lock.withLock {
                 if (!cancelled) {
-                    realmc.invoke_core_notify_callback(schedulerPointer)
+                    realmc.invoke_core_notify_callback(nativeScheduler)
                 }
             }
         }
@@ -41,15 +41,12 @@ actual value class RealmValue actual constructor(
     actual inline fun getFloat(): Float = value.fnum
     actual inline fun getDouble(): Double = value.dnum
 
-    actual inline fun getObjectIdBytes(): ByteArray = ByteArray(OBJECT_ID_BYTES_SIZE).also {
-        value.object_id.bytes.mapIndexed { index, b -> it[index] = b.toByte() }
-    }
+    actual inline fun getObjectIdBytes(): ByteArray = realmc.realm_value_get_object_id(value)
 
-    actual inline fun getUUIDBytes(): ByteArray = ByteArray(UUID_BYTES_SIZE).also {
-        value.uuid.bytes.mapIndexed { index, b -> it[index] = b.toByte() }
-    }
+    actual inline fun getUUIDBytes(): ByteArray = realmc.realm_value_get_uuid(value)
 
-    actual inline fun getDecimal128Array(): ULongArray = value.decimal128.w.toULongArray()
+    actual inline fun getDecimal128Array(): ULongArray =
+        LongArray(2).also { realmc.realm_value_get_decimal128(value, it) }.asULongArray()
 
     actual inline fun getLink(): Link = value.asLink()
 
@@ -19,16 +19,14 @@ package io.realm.kotlin.internal.interop
 
 import io.realm.kotlin.internal.interop.RealmInterop.cptr
 import org.mongodb.kbson.Decimal128
+import java.util.concurrent.atomic.AtomicLongArray
 
 /**
- * Singleton object as we just rely on GC'ed realm_value_ts and don't keep track of the actual
- * allocations besides that.
+ * Transports of primitive values, allocating their realm_value_ts through [allocRealmValueT].
  */
-@Suppress("OVERRIDE_BY_INLINE")
-object JvmMemAllocator : MemAllocator {
+abstract class JvmTransportAllocator : MemAllocator {
 
-    override inline fun allocRealmValueT(): RealmValueT = realm_value_t()
-    override inline fun allocRealmValueList(count: Int): RealmValueList = RealmValueList(count, realmc.new_valueArray(count))
+    override fun allocRealmValueList(count: Int): RealmValueList = RealmValueList(count, realmc.new_valueArray(count))
 
     override fun nullTransport(): RealmValue =
         createTransport(null, realm_value_type_e.RLM_TYPE_NULL)
@@ -55,38 +53,22 @@ object JvmMemAllocator : MemAllocator {
 
     override fun decimal128Transport(value: Decimal128?): RealmValue =
         createTransport(value, realm_value_type_e.RLM_TYPE_DECIMAL128) {
-            decimal128 = realm_decimal128_t().apply {
-                w = ulongArrayOf(it.low, it.high).toLongArray()
-            }
+            realmc.realm_value_set_decimal128(this, it.low.toLong(), it.high.toLong())
         }
 
     override fun objectIdTransport(value: ByteArray?): RealmValue =
         createTransport(value, realm_value_type_e.RLM_TYPE_OBJECT_ID) {
-            object_id = realm_object_id_t().apply {
-                val data = ShortArray(OBJECT_ID_BYTES_SIZE)
-                (0 until OBJECT_ID_BYTES_SIZE).map { index ->
-                    data[index] = it[index].toShort()
-                }
-                bytes = data
-            }
+            realmc.realm_value_set_object_id(this, it)
         }
 
     override fun uuidTransport(value: ByteArray?): RealmValue =
         createTransport(value, realm_value_type_e.RLM_TYPE_UUID) {
-            uuid = realm_uuid_t().apply {
-                val data = ShortArray(UUID_BYTES_SIZE)
-                (0 until UUID_BYTES_SIZE).map { index ->
-                    data[index] = it[index].toShort()
-                }
-                bytes = data
-            }
+            realmc.realm_value_set_uuid(this, it)
         }
 
     override fun decimal128Transport(value: ULongArray?): RealmValue =
         createTransport(value, realm_value_type_e.RLM_TYPE_DECIMAL128) {
-            decimal128 = realm_decimal128_t().apply {
-                w = it.toLongArray()
-            }
+            realmc.realm_value_set_decimal128(this, it[0].toLong(), it[1].toLong())
         }
 
     override fun realmObjectTransport(value: RealmObjectInterop?): RealmValue =
@@ -94,7 +76,7 @@ object JvmMemAllocator : MemAllocator {
             link = realmc.realm_object_as_link(it.objectPointer.cptr())
         }
 
-    private inline fun <T> createTransport(
+    protected inline fun <T> createTransport(
         value: T?,
         type: Int,
         block: (RealmValueT.(value: T) -> Unit) = {}
@@ -109,25 +91,41 @@ object JvmMemAllocator : MemAllocator {
     }
 }
 
+/**
+ * Singleton object handing out realm_value_ts from the innermost scope of the calling thread's
+ * [RealmValueSlab]. Slots are reclaimed when the enclosing [getterScope] or [inputScope] completes.
+ */
+@Suppress("OVERRIDE_BY_INLINE")
+object JvmMemAllocator : JvmTransportAllocator() {
+    override inline fun allocRealmValueT(): RealmValueT = RealmValueSlab.current().alloc()
+}
+
 /**
  * Scoped allocator that will ensure that pointers held by realm_value_ts will be freed again when
  * the allocator is cleaned up. Valid for holders of data buffers, i.e. strings and byte arrays.
  */
-class JvmMemTrackingAllocator : MemAllocator by JvmMemAllocator, MemTrackingAllocator {
+class JvmMemTrackingAllocator : JvmTransportAllocator(), MemTrackingAllocator {
 
     private val scope = MemScope()
+    // The values of this allocator only come from the slab of the thread that created it while its
+    // slab scope is the innermost one, so they are never released by another scope
+    private val slab = RealmValueSlab.current()
+    private val slabScope = slab.enter()
+
+    // Native arena holding the string and binary buffers of the transports of this allocator. It
+    // is only created when needed, as most scopes don't transport any buffers.
+    private var arena: Long = 0
+
+    override fun allocRealmValueT(): RealmValueT = slab.alloc(slabScope)
 
     override fun stringTransport(value: String?): RealmValue =
         createTransport(value, realm_value_type_e.RLM_TYPE_STRING) {
-            string = it
+            realmc.realm_value_set_string(this, it, arena())
         }
 
     override fun byteArrayTransport(value: ByteArray?): RealmValue =
         createTransport(value, realm_value_type_e.RLM_TYPE_BINARY) {
-            binary = realm_binary_t().apply {
-                data = it
-                size = it.size.toLong()
-            }
+            realmc.realm_value_set_binary(this, it, arena())
         }
 
     override fun queryArgsOf(queryArgs: List<RealmQueryArgument>): RealmQueryArgumentList {
@@ -157,41 +155,32 @@ class JvmMemTrackingAllocator : MemAllocator by JvmMemAllocator, MemTrackingAllo
     }
 
     /**
-     * Frees resources linked to this allocator's [scope], more specifically strings and binary
-     * buffers. See [MemScope.free] for more details.
+     * Frees resources linked to this allocator, more specifically the arena holding strings and
+     * binary buffers and the query arguments of the [scope], and returns the allocated slab slots.
+     * See [MemScope.free] for more details.
      */
-    override fun free() = scope.free()
+    override fun free() {
+        scope.free()
+        if (arena != 0L) {
+            realmc.realm_value_arena_free(arena)
+            arena = 0
+        }
+        slab.exit(slabScope)
+    }
 
-    private inline fun <T> createTransport(
-        value: T?,
-        type: Int,
-        block: (RealmValueT.(value: T) -> Unit) = {}
-    ): RealmValue {
-        val struct: realm_value_t = allocRealmValueT()
-        struct.type = when (value) {
-            null -> realm_value_type_e.RLM_TYPE_NULL
-            else -> type
+    private fun arena(): Long {
+        if (arena == 0L) {
+            arena = realmc.realm_value_arena_new()
         }
-        value?.also { block.invoke(struct, it) }
-        scope.manageRealmValue(struct)
-        return RealmValue(struct)
+        return arena
     }
 
     /**
-     * A factory and container for various resources that can be freed when calling [free].
-     *
-     * The `managedRealmValue` should be used for all C-API methods that take a realm_value_t as
-     * input arguments (contrary to output arguments where the data is managed by the C-API and
-     * copied out afterwards).
+     * A factory and container for the query argument arrays that can be freed when calling [free].
      */
     class MemScope {
         val values: MutableSet<Any> = mutableSetOf()
 
-        fun manageRealmValue(value: RealmValueT): RealmValueT {
-            values.add(value)
-            return value
-        }
-
         fun manageQueryArgumentList(value: RealmQueryArgumentList): RealmQueryArgumentList = value.also {
             values.add(value)
         }
@@ -203,7 +192,6 @@ class JvmMemTrackingAllocator : MemAllocator by JvmMemAllocator, MemTrackingAllo
         fun free() {
             values.forEach {
                 when (it) {
-                    is RealmValueT -> realmc.realm_value_t_cleanup(it)
                     is RealmQueryArgumentList -> realmc.delete_queryArgArray(it.head)
                     is RealmQueryListArgument -> realmc.delete_valueArray(it.arguments.head)
                 }
@@ -215,4 +203,124 @@ class JvmMemTrackingAllocator : MemAllocator by JvmMemAllocator, MemTrackingAllo
 actual inline fun realmValueAllocator(): MemAllocator = JvmMemAllocator
 actual inline fun trackingRealmValueAllocator(): MemTrackingAllocator = JvmMemTrackingAllocator()
 
-actual inline fun <R> getterScope(block: MemAllocator.() -> R): R = block(realmValueAllocator())
+actual inline fun <R> getterScope(block: MemAllocator.() -> R): R {
+    val slab = RealmValueSlab.current()
+    val scope = slab.enter()
+    try {
+        return block(realmValueAllocator())
+    } finally {
+        slab.exit(scope)
+    }
+}
+
+/**
+ * Thread local slab of native `realm_value_t` slots.
+ *
+ * Handing out non-owning proxies for slots of the slab avoids a native allocation and, more
+ * importantly, a finalizer registration for every value passed across the JNI boundary. Slots are
+ * allocated in stack order; [enter] opens a scope and [exit] closes it, so values must not be used
+ * after their scope has been closed.
+ *
+ * The slots of a scope are released once it and all scopes opened after it have been closed. A
+ * scope closed out of order, or from another thread, thus keeps its slots until the scopes opened
+ * after it are closed too, and is then released by the thread owning the slab.
+ *
+ * Values allocated outside of a scope, or when all slots are in use, fall back to owning
+ * realm_value_ts that are freed by their finalizer.
+ */
+@PublishedApi
+internal class RealmValueSlab private constructor() {
+    private val owner: Thread = Thread.currentThread()
+    private val address: Long = realmc.realm_value_slab(CAPACITY.toLong())
+    private var next = 0
+    private var depth = 0
+    private var generation = 0L
+    // First slot of each open scope
+    private val marks = IntArray(MAX_DEPTH)
+    // Token of each open scope, cleared when the scope is closed
+    private val open = AtomicLongArray(MAX_DEPTH)
+
+    /**
+     * Opens a scope and returns its token. Scopes nested deeper than the slab supports don't get
+     * slots.
+     */
+    fun enter(): Long {
+        release()
+        if (depth == MAX_DEPTH) {
+            return NO_SCOPE
+        }
+        val token = (++generation shl INDEX_BITS) or depth.toLong()
+        marks[depth] = next
+        open.set(depth, token)
+        depth++
+        return token
+    }
+
+    /**
+     * Closes the scope of the [token]. Can be called from any thread.
+     */
+    fun exit(token: Long) {
+        if (token == NO_SCOPE) {
+            return
+        }
+        // Only closes the scope if its index has not been reused by a later scope
+        open.compareAndSet((token and INDEX_MASK).toInt(), token, NO_SCOPE)
+        if (Thread.currentThread() === owner) {
+            release()
+        }
+    }
+
+    /**
+     * Allocates a value in the innermost open scope of the calling thread.
+     */
+    fun alloc(): realm_value_t {
+        release()
+        return if (depth > 0 && next < CAPACITY) slot() else realm_value_t()
+    }
+
+    /**
+     * Allocates a value in the scope of the [token] if it is the innermost open scope and called
+     * on the thread owning the slab. Otherwise the slot could be released by another scope while
+     * still in use, so the value is allocated individually.
+     */
+    fun alloc(token: Long): realm_value_t {
+        if (token == NO_SCOPE || Thread.currentThread() !== owner) {
+            return realm_value_t()
+        }
+        release()
+        val innermost = depth > 0 && open.get(depth - 1) == token
+        return if (innermost && next < CAPACITY) slot() else realm_value_t()
+    }
+
+    private fun slot(): realm_value_t = SlabRealmValueT(address + next++ * SLOT_SIZE)
+
+    // Releases the slots of the innermost scopes that have been closed
+    private fun release() {
+        while (depth > 0 && open.get(depth - 1) == NO_SCOPE) {
+            depth--
+            next = marks[depth]
+        }
+    }
+
+    companion object {
+        private const val CAPACITY = 256
+        private const val MAX_DEPTH = 64
+        private const val INDEX_BITS = 8
+        private const val INDEX_MASK = (1L shl INDEX_BITS) - 1
+        private const val NO_SCOPE = 0L
+        private val SLOT_SIZE: Long = realmc.realm_value_t_size()
+        private val slabs: ThreadLocal<RealmValueSlab> = ThreadLocal.withInitial { RealmValueSlab() }
+
+        fun current(): RealmValueSlab = slabs.get()
+    }
+}
+
+/**
+ * Non-owning proxy for a slot of a [RealmValueSlab]. It overrides the finalizer of [realm_value_t]
+ * with an empty one, which HotSpot does not register for finalization. ART still registers it, but
+ * it is trivial to run.
+ */
+private class SlabRealmValueT(address: Long) : realm_value_t(address, false) {
+    @Suppress("OVERRIDE_DEPRECATION")
+    override fun finalize() {}
+}
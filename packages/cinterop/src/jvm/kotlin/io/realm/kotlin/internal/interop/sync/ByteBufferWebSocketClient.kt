@@ -0,0 +1,51 @@
+/*
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.kotlin.internal.interop.sync
+
+import io.realm.kotlin.internal.interop.RealmInterop
+import java.nio.ByteBuffer
+
+/**
+ * [WebSocketClient] receiving outgoing Frames as direct buffers wrapping the Frame held by Core,
+ * which avoids copying every Frame into a new [ByteArray]. Core sends Frames to clients
+ * implementing this interface through [send] instead of [WebSocketTransport.write].
+ *
+ * Only available on JVM.
+ */
+interface ByteBufferWebSocketClient : WebSocketClient {
+    /**
+     * Send a binary Frame to the remote peer.
+     *
+     * The [message] is a read-only view of native memory that is only valid while this call runs,
+     * as Core frees it with the websocket. It must thus be copied before returning.
+     * The write must be completed exactly once through
+     * [io.realm.kotlin.internal.interop.RealmInterop.realm_sync_socket_write_complete] once the
+     * Frame has been sent. If this throws, the write is completed as failed and must not be
+     * completed again.
+     */
+    fun send(message: ByteBuffer, writeId: Long)
+}
+
+/**
+ * Forward a received message held in a direct buffer to Core without copying it. The buffer can be
+ * reused or released as soon as this returns.
+ *
+ * Only available on JVM.
+ */
+fun WebSocketObserver.onNewMessage(data: ByteBuffer): Boolean {
+    return RealmInterop.realm_sync_socket_websocket_message(webSocketObserverPointer, data)
+}
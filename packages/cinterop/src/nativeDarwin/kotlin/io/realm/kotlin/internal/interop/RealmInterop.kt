@@ -958,6 +958,47 @@ actual object RealmInterop {
         return RealmValue(struct)
     }
 
+    actual fun realm_get_values(obj: RealmObjectPointer, keys: LongArray): RealmValueRow {
+        memScoped {
+            val values = allocArray<realm_value_t>(keys.size)
+            checkedBooleanResult(
+                realm_wrapper.realm_get_values(
+                    obj.cptr(),
+                    keys.size.toULong(),
+                    keys.toCValues(),
+                    values
+                )
+            )
+            return RealmValueRow(keys.size).also { row ->
+                for (i in keys.indices) {
+                    row.setValue(i, RealmValue(values[i]))
+                }
+            }
+        }
+    }
+
+    actual fun realm_set_values(
+        obj: RealmObjectPointer,
+        values: RealmValueRowBuilder,
+        isDefault: Boolean
+    ) {
+        inputScope {
+            val list = allocRealmValueList(values.size)
+            for (i in 0 until values.size) {
+                list[i] = values.toTransport(this, i)
+            }
+            checkedBooleanResult(
+                realm_wrapper.realm_set_values(
+                    obj.cptr(),
+                    values.size.toULong(),
+                    values.keys.toCValues(),
+                    list.head,
+                    isDefault
+                )
+            )
+        }
+    }
+
     actual fun realm_set_value(
         obj: RealmObjectPointer,
         key: PropertyKey,
@@ -1689,6 +1730,84 @@ actual object RealmInterop {
         return RealmValue(value)
     }
 
+    actual fun realm_results_get_column(
+        results: RealmResultsPointer,
+        key: PropertyKey,
+        values: LongArray,
+        nulls: ByteArray
+    ) = readColumn(results, key, values.size, nulls) { i, value -> values[i] = value.getLong() }
+
+    actual fun realm_results_get_column(
+        results: RealmResultsPointer,
+        key: PropertyKey,
+        values: DoubleArray,
+        nulls: ByteArray
+    ) = readColumn(results, key, values.size, nulls) { i, value -> values[i] = value.getDouble() }
+
+    actual fun realm_results_get_column(
+        results: RealmResultsPointer,
+        key: PropertyKey,
+        values: FloatArray,
+        nulls: ByteArray
+    ) = readColumn(results, key, values.size, nulls) { i, value -> values[i] = value.getFloat() }
+
+    actual fun realm_results_get_column(
+        results: RealmResultsPointer,
+        key: PropertyKey,
+        values: BooleanArray,
+        nulls: ByteArray
+    ) = readColumn(results, key, values.size, nulls) { i, value -> values[i] = value.getBoolean() }
+
+    private inline fun readColumn(
+        results: RealmResultsPointer,
+        key: PropertyKey,
+        count: Int,
+        nulls: ByteArray,
+        set: (Int, RealmValue) -> Unit
+    ) {
+        memScoped {
+            val value = alloc<realm_value_t>()
+            for (i in 0 until count) {
+                val obj = checkedPointerResult(
+                    realm_wrapper.realm_results_get_object(results.cptr(), i.toULong())
+                )
+                try {
+                    checkedBooleanResult(realm_wrapper.realm_get_value(obj, key.key, value.ptr))
+                } finally {
+                    realm_wrapper.realm_release(obj)
+                }
+                val realmValue = RealmValue(value)
+                if (realmValue.isNull()) {
+                    nulls[i / 8] = (nulls[i / 8].toInt() or (1 shl (i % 8))).toByte()
+                } else {
+                    set(i, realmValue)
+                }
+            }
+        }
+    }
+
+    actual fun realm_results_get_range(
+        results: RealmResultsPointer,
+        from: Long,
+        count: Int
+    ): RealmValueRow {
+        memScoped {
+            val value = alloc<realm_value_t>()
+            return RealmValueRow(count).also { row ->
+                for (i in 0 until count) {
+                    checkedBooleanResult(
+                        realm_wrapper.realm_results_get(
+                            results.cptr(),
+                            (from + i).toULong(),
+                            value.ptr
+                        )
+                    )
+                    row.setValue(i, RealmValue(value))
+                }
+            }
+        }
+    }
+
     actual fun realm_results_get_list(results: RealmResultsPointer, index: Long): RealmListPointer =
         CPointerWrapper(realm_wrapper.realm_results_get_list(results.cptr(), index.toULong()))
 
@@ -1921,7 +2040,15 @@ actual object RealmInterop {
 
     private inline fun <reified T : CVariable> MemScope.initArray(size: CArrayPointer<ULongVar>) = allocArray<T>(size[0].toInt())
 
-    actual fun <T, R> realm_collection_changes_get_indices(change: RealmChangesPointer, builder: CollectionChangeSetBuilder<T, R>) {
+    actual fun <T, R> realm_collection_changes_get_change_set(
+        change: RealmChangesPointer,
+        builder: CollectionChangeSetBuilder<T, R>
+    ) {
+        realm_collection_changes_get_indices(change, builder)
+        realm_collection_changes_get_ranges(change, builder)
+    }
+
+    private fun <T, R> realm_collection_changes_get_indices(change: RealmChangesPointer, builder: CollectionChangeSetBuilder<T, R>) {
         memScoped {
             val insertionCount = allocArray<ULongVar>(1)
             val deletionCount = allocArray<ULongVar>(1)
@@ -1968,7 +2095,7 @@ actual object RealmInterop {
         }
     }
 
-    actual fun <T, R> realm_collection_changes_get_ranges(change: RealmChangesPointer, builder: CollectionChangeSetBuilder<T, R>) {
+    private fun <T, R> realm_collection_changes_get_ranges(change: RealmChangesPointer, builder: CollectionChangeSetBuilder<T, R>) {
         memScoped {
             val insertRangesCount = allocArray<ULongVar>(1)
             val deleteRangesCount = allocArray<ULongVar>(1)
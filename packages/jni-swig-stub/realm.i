@@ -280,17 +280,9 @@ typedef jstring realm_string_t;
 }
 // Clean up of jstring buffers are managed by the lifetime of the `tmp` JStringAccessor
 %typemap(freearg) realm_string_t ""
-// Typemap used for passing realm_string_t into the C-API in situations where the string buffer
-// needs to be kept alive after returning from C-API call. This will copy the string buffer to the
-// heap and this has to be explicitly freed at a later point.
-// Currently just matching 'realm_string_t string' arguments to match realm_value_t.string = $input
-%typemap(in) realm_string_t string {
-    auto s = JStringAccessor(jenv, $arg);
-    auto size = s.size();
-    $1.size = size;
-    $1.data = (char const *) (new char[size]);
-    memcpy((char *)$1.data, (const char *)s.data(), size);
-}
+// The string of a realm_value_t must outlive the setter, so it has no setter. Strings are copied
+// into a scoped arena through `realm_value_set_string` in realm_api_helpers.h instead.
+%immutable realm_value::string;
 %typemap(out) (realm_string_t) "$result = to_jstring(jenv, StringData{$1.data, $1.size});"
 
 // Type map to allow passing void* as Long
@@ -495,9 +487,9 @@ $result = SWIG_JavaArrayOutLonglong(jenv, (long long *)result, 2);
 }
 // -- End
 
-// FIXME OPTIMIZE Support getting/setting multiple attributes. Ignored for now due to incorrect
-//  type cast in Swig-generated wrapper for "const realm_property_key_t*" which is not cast
-//  correctly to the underlying C-API method.
+// Ignored due to incorrect type cast in Swig-generated wrapper for "const realm_property_key_t*"
+// which is not cast correctly to the underlying C-API method. Multiple values are instead read and
+// written through `realm_get_values_packed` and `realm_set_values_packed` in realm_api_helpers.h.
 %ignore "realm_get_values";
 %ignore "realm_set_values";
 // Not yet available in library
@@ -15,9 +15,32 @@
  */
 
 #include "realm_api_helpers.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <memory>
+#include <string>
 #include <vector>
 #include <thread>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
 #include <realm/object-store/c_api/util.hpp>
+#include <realm/object-store/impl/collection_change_builder.hpp>
+#include <realm/object-store/shared_realm.hpp>
 #include "java_method.hpp"
 
 using namespace realm::jni_util;
@@ -94,6 +117,26 @@ inline jobject create_java_exception(JNIEnv *jenv, realm_error_t error) {
     return jenv->PopLocalFrame(exception);
 }
 
+// Address of `size` bytes at `offset` of a direct buffer. If the buffer is not a direct buffer or
+// does not hold the range an InvalidArgument error is set as the last error and nullptr returned.
+static char* direct_buffer_range(JNIEnv* jenv, jobject buffer, int64_t offset, int64_t size) {
+    char* address = nullptr;
+    realm::c_api::wrap_err([&]() {
+        auto data = static_cast<char*>(jenv->GetDirectBufferAddress(buffer));
+        if (!data) {
+            throw realm::InvalidArgument("Buffer must be a direct buffer");
+        }
+        jlong capacity = jenv->GetDirectBufferCapacity(buffer);
+        if (offset < 0 || size < 0 || offset > capacity || size > capacity - offset) {
+            throw realm::InvalidArgument(realm::util::format("Range of %1 bytes at offset %2 is outside of buffer of %3 bytes",
+                                                             size, offset, capacity));
+        }
+        address = data + offset;
+        return true;
+    });
+    return address;
+}
+
 bool throw_last_error_as_java_exception(JNIEnv *jenv) {
     realm_error_t error;
     if (realm_get_last_error(&error)) {
@@ -163,88 +206,716 @@ bool migration_callback(void *userdata, realm_t *old_realm, realm_t *new_realm,
     return failed;
 }
 
-// TODO OPTIMIZE Abstract pattern for all notification registrations for collections that receives
-//  changes as realm_collection_changes_t.
-realm_notification_token_t *
-register_results_notification_cb(realm_results_t *results,
-                                 int64_t key_path_array_ptr,
-                                 jobject callback) {
-    auto jenv = get_env();
-    static JavaMethod on_change_method(jenv, JavaClassGlobalDef::notification_callback(),
-                                       "onChange", "(J)V");
+// *** BEGIN - Notification latency *** //
 
-    return realm_results_add_notification_callback(
-            results,
-            // Use the callback as user data
-            static_cast<jobject>(get_env()->NewGlobalRef(callback)),
-            [](void *userdata) {
-                get_env(true)->DeleteGlobalRef(static_cast<jobject>(userdata));
-            },
-            reinterpret_cast<realm_key_path_array_t*>(key_path_array_ptr),
-            // change callback
-            [](void *userdata, const realm_collection_changes_t *changes) {
-                // TODO API-NOTIFICATION Consider catching errors and propagate to error callback
-                //  like the C-API error callback below
-                //  https://github.com/realm/realm-kotlin/issues/889
-                auto jenv = get_env(true);
-                jni_check_exception(jenv);
-                jenv->CallVoidMethod(static_cast<jobject>(userdata),
-                                     on_change_method,
-                                     reinterpret_cast<jlong>(changes));
-                jni_check_exception(jenv);
+static int64_t monotonic_nanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Log-linear histogram of durations in the spirit of HdrHistogram. Values are bucketed by their
+// highest set bit and the SUB_BUCKET_BITS bits following it, which bounds the relative error of
+// the reported percentiles to 1/2^SUB_BUCKET_BITS. Values can be recorded on one thread while the
+// histogram is summarized on another.
+class LatencyHistogram {
+public:
+    // Number of values written by `summarize`
+    static constexpr size_t SUMMARY_SIZE = 8;
+
+    LatencyHistogram() {
+        for (auto& bucket : m_buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void record(int64_t nanos) {
+        uint64_t value = std::min<uint64_t>(std::max<int64_t>(nanos, 0), MAX_VALUE);
+        m_buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+        uint64_t min = m_min.load(std::memory_order_relaxed);
+        while (value < min && !m_min.compare_exchange_weak(min, value, std::memory_order_relaxed)) {}
+        uint64_t max = m_max.load(std::memory_order_relaxed);
+        while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+    }
+
+    // Writes the count, min, max, mean, p50, p90, p99 and p99.9 to `out`. Percentiles are reported
+    // as the highest value of their bucket.
+    void summarize(jlong* out) const {
+        static constexpr double percentiles[] = {0.5, 0.9, 0.99, 0.999};
+        std::array<uint64_t, BUCKETS> buckets;
+        uint64_t count = 0;
+        for (size_t i = 0; i < BUCKETS; i++) {
+            buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+            count += buckets[i];
+        }
+        std::fill(out, out + SUMMARY_SIZE, 0);
+        if (count == 0) {
+            return;
+        }
+        uint64_t max = m_max.load(std::memory_order_relaxed);
+        out[0] = count;
+        out[1] = m_min.load(std::memory_order_relaxed);
+        out[2] = max;
+        out[3] = m_sum.load(std::memory_order_relaxed) / count;
+        size_t percentile = 0;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS && percentile < 4; i++) {
+            seen += buckets[i];
+            while (percentile < 4 &&
+                   seen >= std::max<uint64_t>(1, std::ceil(percentiles[percentile] * count))) {
+                out[4 + percentile++] = std::min(bucket_upper_bound(i), max);
             }
-    );
+        }
+    }
+
+private:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr uint64_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    // Durations are clamped to 2^40 ns, roughly 18 minutes
+    static constexpr int MAX_MAGNITUDE = 40;
+    static constexpr uint64_t MAX_VALUE = (uint64_t(1) << MAX_MAGNITUDE) - 1;
+    static constexpr size_t BUCKETS = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    static size_t bucket_index(uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return value;
+        }
+        int magnitude = highest_bit(value);
+        int shift = magnitude - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+    }
+
+    static int highest_bit(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+
+    static uint64_t bucket_upper_bound(size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        size_t shift = index / SUB_BUCKETS - 1;
+        return ((SUB_BUCKETS + index % SUB_BUCKETS + 1) << shift) - 1;
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKETS> m_buckets;
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_min{UINT64_MAX};
+    std::atomic<uint64_t> m_max{0};
+};
+
+// Stages of delivering a notification for a commit
+enum LatencyStage {
+    // From the commit to the scheduler being notified by the core notifier
+    COMMIT_TO_NOTIFY,
+    // From the scheduler being notified to the work being performed on the scheduler's thread
+    NOTIFY_TO_DISPATCH,
+    // From performing the work to entering the notification callback
+    DISPATCH_TO_CALLBACK,
+    // From the commit to entering the notification callback
+    COMMIT_TO_CALLBACK,
+    LATENCY_STAGES,
+};
+
+static LatencyHistogram s_latency[LATENCY_STAGES];
+
+// Start of the most recent commit performed through `realm_commit_tracked` on a realm file. Shared
+// by the schedulers of all realms of the file, so commits are only attributed to notifications
+// they can have triggered.
+struct CommitClock {
+    std::atomic<int64_t> last_commit_nanos{0};
+
+    static std::shared_ptr<CommitClock> for_path(const std::string& path) {
+        static std::mutex mutex;
+        static std::unordered_map<std::string, std::weak_ptr<CommitClock>> clocks;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = clocks.find(path);
+        if (it != clocks.end()) {
+            if (auto clock = it->second.lock()) {
+                return clock;
+            }
+        } else {
+            // Only files with an active scheduler keep their clock, so drop the ones of closed files
+            // before adding another one
+            for (auto entry = clocks.begin(); entry != clocks.end();) {
+                entry = entry->second.expired() ? clocks.erase(entry) : std::next(entry);
+            }
+        }
+        auto clock = std::make_shared<CommitClock>();
+        clocks[path] = clock;
+        return clock;
+    }
+};
+
+// Commits attributed to the notifications of a scheduler. The clock is bound once the realm of the
+// scheduler has been opened, see `realm_scheduler_track_commits`.
+struct CommitAttribution {
+    std::shared_ptr<CommitClock> clock() const {
+        return std::atomic_load_explicit(&m_clock, std::memory_order_acquire);
+    }
+
+    void bind(std::shared_ptr<CommitClock> clock) {
+        std::atomic_store_explicit(&m_clock, std::move(clock), std::memory_order_release);
+    }
+
+    std::atomic<int64_t> last_attributed{0};
+
+private:
+    std::shared_ptr<CommitClock> m_clock;
+};
+
+// Timestamps of a scheduler notification, zero if unknown
+struct NotificationTiming {
+    int64_t commit_nanos = 0;
+    int64_t notified_nanos = 0;
+    int64_t dispatched_nanos = 0;
+
+    // Captures the timing of a notification of a scheduler. Schedulers are also notified for other
+    // reasons than commits, so only the first notification after a commit is attributed to it.
+    static NotificationTiming notified(CommitAttribution& commits) {
+        NotificationTiming timing;
+        timing.notified_nanos = monotonic_nanos();
+        auto clock = commits.clock();
+        if (!clock) {
+            return timing;
+        }
+        int64_t commit = clock->last_commit_nanos.load(std::memory_order_relaxed);
+        int64_t attributed = commits.last_attributed.load(std::memory_order_relaxed);
+        if (commit > attributed &&
+            commits.last_attributed.compare_exchange_strong(attributed, commit, std::memory_order_relaxed)) {
+            timing.commit_nanos = commit;
+            s_latency[COMMIT_TO_NOTIFY].record(timing.notified_nanos - commit);
+        }
+        return timing;
+    }
+
+    // Timing of the notification whose work is currently performed on this thread, if any
+    static const NotificationTiming*& current() {
+        static thread_local const NotificationTiming* timing = nullptr;
+        return timing;
+    }
+};
+
+bool
+realm_commit_tracked(realm_t* realm) {
+    // Clock of the realm last committed on this thread. The writes of a realm are performed on a
+    // single thread, so the clock of a realm is only resolved through `for_path` by its first
+    // commit. The weak reference compares by ownership and so cannot match a later realm that
+    // reuses the address.
+    thread_local struct {
+        std::weak_ptr<realm::Realm> realm;
+        std::shared_ptr<CommitClock> clock;
+    } last;
+    const realm::SharedRealm& shared_realm = *realm;
+    if (!last.clock || last.realm.owner_before(shared_realm) || shared_realm.owner_before(last.realm)) {
+        last.realm = shared_realm;
+        last.clock = CommitClock::for_path(shared_realm->config().path);
+    }
+    // Taken before committing as the notifier might already pick up the commit before it returns
+    last.clock->last_commit_nanos.store(monotonic_nanos(), std::memory_order_relaxed);
+    return realm_commit(realm);
 }
 
-realm_on_object_change_func_t get_on_object_change() {
-    auto jenv = get_env(true);
-    static JavaMethod on_change_method(jenv, JavaClassGlobalDef::notification_callback(),
-                                       "onChange", "(J)V");
-    return [](realm_userdata_t userdata, const realm_object_changes_t* changes) {
-        // TODO API-NOTIFICATION Consider catching errors and propagate to error callback
-        //  like the C-API error callback below
-        //  https://github.com/realm/realm-kotlin/issues/889
-        auto jenv = get_env(true);
-        jni_check_exception(jenv);
-        jenv->CallVoidMethod(static_cast<jobject>(userdata),
-                             on_change_method,
-                             reinterpret_cast<jlong>(changes));
-        jni_check_exception(jenv);
+// *** END - Notification latency *** //
+
+// *** BEGIN - Key path cache *** //
+
+// Reference to a key path array shared through the cache. Released like any other C-API object,
+// the array itself is released once neither the cache nor any reference holds on to it.
+struct SharedKeyPathArray : realm::c_api::WrapC {
+    explicit SharedKeyPathArray(std::shared_ptr<realm_key_path_array_t> array)
+            : array(std::move(array)) {}
+
+    std::shared_ptr<realm_key_path_array_t> array;
+};
+
+// Least recently used key path arrays, keyed by the realm file, schema version, class and the
+// normalized key paths. Column keys are stable for a schema version, so a resolved key path array
+// stays valid for all versions of a realm. A file that is deleted and recreated can assign other
+// keys for the same schema version though, so entries are only valid for the DB instance they were
+// resolved with, which is replaced when the file is reopened after deleting it.
+class KeyPathArrayCache {
+public:
+    static constexpr size_t CAPACITY = 256;
+
+    std::shared_ptr<realm_key_path_array_t> get(const std::string& key,
+                                                const std::shared_ptr<realm::DB>& db) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            return nullptr;
+        }
+        if (it->second.db.lock() != db) {
+            m_order.erase(it->second.position);
+            m_entries.erase(it);
+            return nullptr;
+        }
+        m_order.splice(m_order.begin(), m_order, it->second.position);
+        return it->second.array;
+    }
+
+    void put(const std::string& key, const std::shared_ptr<realm::DB>& db,
+             std::shared_ptr<realm_key_path_array_t> array) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_entries.count(key)) {
+            return;
+        }
+        if (m_entries.size() == CAPACITY) {
+            m_entries.erase(m_order.back());
+            m_order.pop_back();
+        }
+        m_order.push_front(key);
+        m_entries.emplace(key, Entry{std::move(array), db, m_order.begin()});
+    }
+
+private:
+    struct Entry {
+        std::shared_ptr<realm_key_path_array_t> array;
+        // Not keeping the DB alive, so entries of closed files expire
+        std::weak_ptr<realm::DB> db;
+        std::list<std::string>::iterator position;
     };
+
+    std::mutex m_mutex;
+    std::list<std::string> m_order;
+    std::unordered_map<std::string, Entry> m_entries;
+};
+
+static KeyPathArrayCache s_key_path_arrays;
+
+int64_t
+realm_key_path_array_cached(const realm_t* realm, int64_t class_key, size_t num_key_paths,
+                            char** key_paths) {
+    // Key paths are a filter, so neither their order nor duplicates matter
+    std::vector<std::string> normalized(key_paths, key_paths + num_key_paths);
+    bool has_wildcard = std::any_of(normalized.begin(), normalized.end(), [](const std::string& key_path) {
+        return key_path.find('*') != std::string::npos;
+    });
+    std::sort(normalized.begin(), normalized.end());
+    normalized.erase(std::unique(normalized.begin(), normalized.end()), normalized.end());
+
+    const auto& shared_realm = *realm;
+    std::string key = shared_realm->config().path;
+    key.append(1, '\0').append(std::to_string(shared_realm->schema_version()));
+    key.append(1, '\0').append(std::to_string(class_key));
+    for (const auto& key_path : normalized) {
+        key.append(1, '\0').append(key_path);
+    }
+
+    const auto& db = realm::Realm::Internal::get_db(*shared_realm);
+    std::shared_ptr<realm_key_path_array_t> array = s_key_path_arrays.get(key, db);
+    if (!array) {
+        std::vector<const char*> c_key_paths;
+        c_key_paths.reserve(normalized.size());
+        for (const auto& key_path : normalized) {
+            c_key_paths.push_back(key_path.c_str());
+        }
+        realm_key_path_array_t* created = realm_create_key_path_array(
+                realm, static_cast<realm_class_key_t>(class_key), c_key_paths.size(),
+                c_key_paths.data());
+        if (!created) {
+            throw_last_error_as_java_exception(get_env(true));
+            return 0;
+        }
+        array.reset(created, [](realm_key_path_array_t* array) { realm_release(array); });
+        // Wildcards are expanded to the properties of the current schema, which can be extended
+        // without a new schema version. Empty arrays don't resolve anything worth sharing.
+        if (!has_wildcard && !normalized.empty()) {
+            s_key_path_arrays.put(key, db, array);
+        }
+    }
+    return reinterpret_cast<int64_t>(new SharedKeyPathArray(std::move(array)));
 }
 
-realm_on_collection_change_func_t get_on_collection_change() {
-    auto jenv = get_env(true);
-    static JavaMethod on_change_method(jenv, JavaClassGlobalDef::notification_callback(),
-                                       "onChange", "(J)V");
-    return [](realm_userdata_t userdata, const realm_collection_changes_t* changes) {
-        // TODO API-NOTIFICATION Consider catching errors and propagate to error callback
-        //  like the C-API error callback below
-        //  https://github.com/realm/realm-kotlin/issues/889
+static realm_key_path_array_t* shared_key_path_array(int64_t key_path_array_ptr) {
+    if (!key_path_array_ptr) {
+        return nullptr;
+    }
+    return reinterpret_cast<SharedKeyPathArray*>(key_path_array_ptr)->array.get();
+}
+
+bool
+realm_key_path_arrays_shared_for_testing(int64_t key_path_array_ptr, int64_t other_ptr) {
+    return shared_key_path_array(key_path_array_ptr) == shared_key_path_array(other_ptr);
+}
+
+// *** END - Key path cache *** //
+
+// *** BEGIN - Notifications *** //
+
+// Delivery policy of a notification registration
+enum NotificationPolicy : int32_t {
+    // Every change is delivered as soon as it is available
+    DELIVER_ALL = 0,
+    // After delivering a change, further changes are merged into a single pending change until the
+    // receiver signals that it is ready through `realm_notification_ready`
+    MERGE = 1,
+};
+
+// State of a single notification registration. It is passed as userdata to core and released
+// through the userdata free function when the registration is removed.
+struct NotificationSubscription {
+    NotificationSubscription(JNIEnv* jenv, jobject callback, NotificationPolicy policy)
+            : callback(jenv->NewGlobalRef(callback)), policy(policy) {}
+
+    ~NotificationSubscription() {
+        if (LatencyHistogram* histogram = latency.load(std::memory_order_relaxed)) {
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex());
+                registry().erase(this);
+            }
+            delete histogram;
+        }
+        if (pending) {
+            realm_release(pending);
+        }
+        get_env(true)->DeleteGlobalRef(callback);
+    }
+
+    // Active registrations that recorded a latency, guarded by `registry_mutex`
+    static std::unordered_set<NotificationSubscription*>& registry() {
+        static std::unordered_set<NotificationSubscription*> subscriptions;
+        return subscriptions;
+    }
+
+    static std::mutex& registry_mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    // Records the latency of a notification entering the callback of the registration
+    void record_latency() {
+        auto timing = NotificationTiming::current();
+        if (!timing || !timing->dispatched_nanos) {
+            return;
+        }
+        int64_t now = monotonic_nanos();
+        s_latency[DISPATCH_TO_CALLBACK].record(now - timing->dispatched_nanos);
+        if (!timing->commit_nanos) {
+            return;
+        }
+        s_latency[COMMIT_TO_CALLBACK].record(now - timing->commit_nanos);
+        // Only allocated and registered for registrations that are notified about commits, so
+        // registrations that are never notified don't contend on the registry
+        LatencyHistogram* histogram = latency.load(std::memory_order_relaxed);
+        if (!histogram) {
+            histogram = new LatencyHistogram();
+            latency.store(histogram, std::memory_order_release);
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            registry().insert(this);
+        }
+        histogram->record(now - timing->commit_nanos);
+    }
+
+    jobject callback;
+    // The initial notification is always delivered as it signals the start of the observation
+    bool initial_delivered = false;
+    NotificationPolicy policy;
+    // Whether a delivered change has not been acknowledged by the receiver yet
+    bool in_flight = false;
+    // Changes merged while a change was in flight
+    void* pending = nullptr;
+    // Commit to callback latency of this registration, only written on the notifying thread
+    std::atomic<LatencyHistogram*> latency{nullptr};
+};
+
+// Whether the subscriber would ignore the change, i.e. it does not report any changes. Properties
+// and elements outside of the key paths of the registration are already filtered by core.
+// Deletions are never ignored.
+template <typename Changes>
+bool is_ignorable_change(const Changes* changes);
+
+template <>
+bool is_ignorable_change(const realm_object_changes_t* changes) {
+    return !realm_object_changes_is_deleted(changes) &&
+           realm_object_changes_get_num_modified_properties(changes) == 0;
+}
+
+template <>
+bool is_ignorable_change(const realm_collection_changes_t* changes) {
+    size_t deletions, insertions, modifications, moves;
+    bool was_cleared, was_deleted;
+    realm_collection_changes_get_num_changes(changes, &deletions, &insertions, &modifications,
+                                             &moves, &was_cleared, &was_deleted);
+    return deletions == 0 && insertions == 0 && modifications == 0 && moves == 0 &&
+           !was_cleared && !was_deleted;
+}
+
+template <>
+bool is_ignorable_change(const realm_dictionary_changes_t* changes) {
+    size_t deletions, insertions, modifications;
+    bool was_deleted;
+    realm_dictionary_get_changes(changes, &deletions, &insertions, &modifications, &was_deleted);
+    return deletions == 0 && insertions == 0 && modifications == 0 && !was_deleted;
+}
+
+static std::atomic<bool> s_batched_notifications(true);
+// Number of changes merged into a pending change across all registrations
+static std::atomic<int64_t> s_merged_notifications(0);
+
+// Notifications gathered on a thread while performing the work of a scheduler. They are delivered
+// to the `NotificationMultiplexer` in a single upcall once the work is done instead of one upcall
+// per notification.
+class NotificationBatch {
+public:
+    NotificationBatch() : m_previous(current()) {
+        current() = this;
+    }
+
+    ~NotificationBatch() {
+        uninstall();
+        // Only left if performing the work failed
+        for (void* changes : m_changes) {
+            realm_release(changes);
+        }
+        if (!m_callbacks.empty()) {
+            release_callbacks(get_env(true), m_callbacks);
+        }
+    }
+
+    static NotificationBatch*& current() {
+        static thread_local NotificationBatch* batch = nullptr;
+        return batch;
+    }
+
+    // The callback of a registration is released when the registration is removed, which can
+    // happen before the batch is flushed, so the batch holds its own reference
+    void add(jobject callback, void* changes) {
+        m_callbacks.push_back(get_env(true)->NewGlobalRef(callback));
+        m_changes.push_back(changes);
+    }
+
+    void flush() {
+        // Notifications triggered from the callbacks are delivered directly
+        uninstall();
+        if (m_changes.empty()) {
+            return;
+        }
         auto jenv = get_env(true);
+        static JavaMethod on_changes_method(jenv, JavaClassGlobalDef::notification_multiplexer(),
+                                            "onChanges",
+                                            "([Lio/realm/kotlin/internal/interop/NotificationCallback;[J)V",
+                                            true);
+        jsize size = static_cast<jsize>(m_changes.size());
+        jenv->PushLocalFrame(2);
+        jobjectArray callbacks = jenv->NewObjectArray(size, JavaClassGlobalDef::notification_callback(), nullptr);
+        for (jsize i = 0; i < size; i++) {
+            jenv->SetObjectArrayElement(callbacks, i, m_callbacks[i]);
+        }
+        std::vector<jlong> pointers(m_changes.size());
+        std::transform(m_changes.begin(), m_changes.end(), pointers.begin(),
+                       [](void* changes) { return reinterpret_cast<jlong>(changes); });
+        jlongArray changes = jenv->NewLongArray(size);
+        jenv->SetLongArrayRegion(changes, 0, size, pointers.data());
+        // Ownership of the changes is passed on to the multiplexer
+        std::vector<jobject> delivered;
+        delivered.swap(m_callbacks);
+        m_changes.clear();
+        jenv->CallStaticVoidMethod(JavaClassGlobalDef::notification_multiplexer(), on_changes_method,
+                                   callbacks, changes);
+        jenv->PopLocalFrame(nullptr);
+        release_callbacks(jenv, delivered);
         jni_check_exception(jenv);
-        jenv->CallVoidMethod(static_cast<jobject>(userdata),
-                             on_change_method,
-                             reinterpret_cast<jlong>(changes));
-        jni_check_exception(jenv);
+    }
+
+private:
+    void uninstall() {
+        if (current() == this) {
+            current() = m_previous;
+        }
+    }
+
+    static void release_callbacks(JNIEnv* jenv, std::vector<jobject>& callbacks) {
+        for (jobject callback : callbacks) {
+            jenv->DeleteGlobalRef(callback);
+        }
+        callbacks.clear();
+    }
+
+    NotificationBatch* m_previous;
+    std::vector<jobject> m_callbacks;
+    std::vector<void*> m_changes;
+};
+
+// Performs the work of a scheduler, delivering all notifications triggered by it in one batch.
+// Latencies are recorded for the notifications if the timing of the scheduler notification is known.
+static void perform_work(realm_work_queue_t* work_queue, const NotificationTiming* timing = nullptr) {
+    auto previous_timing = std::exchange(NotificationTiming::current(), timing);
+    if (!s_batched_notifications.load(std::memory_order_relaxed)) {
+        realm_scheduler_perform_work(work_queue);
+    } else {
+        NotificationBatch batch;
+        realm_scheduler_perform_work(work_queue);
+        batch.flush();
+    }
+    NotificationTiming::current() = previous_timing;
+}
+
+void
+realm_set_batched_notifications(bool enabled) {
+    s_batched_notifications.store(enabled, std::memory_order_relaxed);
+}
+
+// Merges two consecutive changes into a change spanning both, the same way core merges the changes
+// of versions skipped by a notifier. Object and collection changes are both backed by a
+// CollectionChangeSet.
+static realm::CollectionChangeSet merge_change_sets(const realm::CollectionChangeSet& older,
+                                                    const realm::CollectionChangeSet& newer) {
+    // The builder tracks modifications by their index in the new collection and derives the
+    // indices in the old collection from them when finalizing
+    auto to_builder = [](const realm::CollectionChangeSet& changes) {
+        realm::_impl::CollectionChangeBuilder builder(changes.deletions, changes.insertions,
+                                                      changes.modifications_new, changes.moves,
+                                                      changes.collection_root_was_deleted);
+        builder.columns = changes.columns;
+        return builder;
     };
+    auto merged = to_builder(older);
+    merged.merge(to_builder(newer));
+    realm::CollectionChangeSet result = std::move(merged).finalize();
+    result.collection_was_cleared = older.collection_was_cleared || newer.collection_was_cleared;
+    return result;
 }
 
-realm_on_dictionary_change_func_t get_on_dictionary_change() {
+// Dictionary changes are keyed by value and are not merged, they are always delivered right away
+template <typename Changes>
+constexpr bool is_mergeable = !std::is_same<Changes, realm_dictionary_changes_t>::value;
+
+// Delivers a change to the receiver, passing on ownership of the change. A change of a merging
+// registration is in flight until the receiver signals that it is ready, which it can do while
+// handling the change, so it is marked before handing it off and unmarked if the handoff fails.
+static void deliver_change(NotificationSubscription* subscription, void* changes) {
+    if (subscription->policy == MERGE) {
+        subscription->in_flight = true;
+    }
+    if (auto batch = NotificationBatch::current()) {
+        // The multiplexer notifies every callback of the batch, even if some of them fail
+        batch->add(subscription->callback, changes);
+        return;
+    }
+    // TODO API-NOTIFICATION Consider catching errors and propagate to error callback
+    //  like the C-API error callback below
+    //  https://github.com/realm/realm-kotlin/issues/889
     auto jenv = get_env(true);
     static JavaMethod on_change_method(jenv, JavaClassGlobalDef::notification_callback(),
                                        "onChange", "(J)V");
-    return [](realm_userdata_t userdata, const realm_dictionary_changes_t* changes) {
-        // TODO API-NOTIFICATION Consider catching errors and propagate to error callback
-        //  like the C-API error callback below
-        //  https://github.com/realm/realm-kotlin/issues/889
-        auto jenv = get_env(true);
-        jni_check_exception(jenv);
-        jenv->CallVoidMethod(static_cast<jobject>(userdata),
-                             on_change_method,
-                             reinterpret_cast<jlong>(changes));
-        jni_check_exception(jenv);
-    };
+    jni_check_exception(jenv);
+    jenv->CallVoidMethod(subscription->callback,
+                         on_change_method,
+                         reinterpret_cast<jlong>(changes));
+    if (!jni_check_exception(jenv)) {
+        // Otherwise further changes would be merged forever as the receiver never signals
+        subscription->in_flight = false;
+    }
+}
+
+template <typename Changes>
+void on_change(realm_userdata_t userdata, const Changes* changes) {
+    auto subscription = static_cast<NotificationSubscription*>(userdata);
+    subscription->record_latency();
+    if (subscription->initial_delivered && is_ignorable_change(changes)) {
+        return;
+    }
+    subscription->initial_delivered = true;
+    if constexpr (is_mergeable<Changes>) {
+        if (subscription->in_flight) {
+            auto pending = static_cast<Changes*>(subscription->pending);
+            if (pending) {
+                subscription->pending = new Changes(merge_change_sets(*pending, *changes));
+                realm_release(pending);
+            } else {
+                subscription->pending = realm_clone(changes);
+            }
+            s_merged_notifications.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    // The changes are only valid during the callback, so the receiver gets its own copy
+    deliver_change(subscription, realm_clone(changes));
+}
+
+void
+realm_notification_ready(int64_t subscription_ptr) {
+    auto subscription = reinterpret_cast<NotificationSubscription*>(subscription_ptr);
+    subscription->in_flight = false;
+    if (subscription->pending) {
+        void* pending = subscription->pending;
+        subscription->pending = nullptr;
+        deliver_change(subscription, pending);
+    }
+}
+
+int64_t
+realm_merged_notifications() {
+    return s_merged_notifications.load(std::memory_order_relaxed);
+}
+
+jlongArray
+realm_notification_latency_stats() {
+    constexpr size_t summary_size = LatencyHistogram::SUMMARY_SIZE;
+    std::vector<jlong> stats(LATENCY_STAGES * summary_size);
+    for (size_t stage = 0; stage < LATENCY_STAGES; stage++) {
+        s_latency[stage].summarize(&stats[stage * summary_size]);
+    }
+    {
+        std::lock_guard<std::mutex> lock(NotificationSubscription::registry_mutex());
+        for (auto subscription : NotificationSubscription::registry()) {
+            if (auto histogram = subscription->latency.load(std::memory_order_acquire)) {
+                stats.push_back(reinterpret_cast<jlong>(subscription));
+                stats.resize(stats.size() + summary_size);
+                histogram->summarize(&stats[stats.size() - summary_size]);
+            }
+        }
+    }
+    auto jenv = get_env(true);
+    jsize size = static_cast<jsize>(stats.size());
+    jlongArray result = jenv->NewLongArray(size);
+    jenv->SetLongArrayRegion(result, 0, size, stats.data());
+    return result;
+}
+
+// Registers the callback through one of the `realm_*_add_notification_callback` functions of the
+// C-API, which all share the same signature apart from the type of the observed entity and the
+// change.
+template <typename Changes, typename Observable, typename KeyPaths, typename OnChange>
+realm_notification_token_t*
+add_notification_callback(
+        realm_notification_token_t* (*add_callback)(Observable*, realm_userdata_t, realm_free_userdata_func_t, KeyPaths*, OnChange),
+        int64_t observable_ptr,
+        int64_t key_path_array_ptr,
+        jobject callback,
+        int32_t policy,
+        jlongArray out_subscription) {
+    auto jenv = get_env();
+    auto subscription = new NotificationSubscription(jenv, callback,
+                                                     static_cast<NotificationPolicy>(policy));
+    if (out_subscription) {
+        jlong subscription_ptr = reinterpret_cast<jlong>(subscription);
+        jenv->SetLongArrayRegion(out_subscription, 0, 1, &subscription_ptr);
+    }
+    return add_callback(
+            reinterpret_cast<Observable*>(observable_ptr),
+            subscription,
+            [](void* userdata) { delete static_cast<NotificationSubscription*>(userdata); },
+            shared_key_path_array(key_path_array_ptr),
+            on_change<Changes>
+    );
+}
+
+realm_notification_token_t *
+register_results_notification_cb(realm_results_t *results,
+                                 int64_t key_path_array_ptr,
+                                 jobject callback,
+                                 int32_t policy,
+                                 jlongArray out_subscription) {
+    return add_notification_callback<realm_collection_changes_t>(
+            realm_results_add_notification_callback, reinterpret_cast<int64_t>(results),
+            key_path_array_ptr, callback, policy, out_subscription);
 }
 
 realm_notification_token_t *
@@ -252,46 +923,36 @@ register_notification_cb(
         int64_t collection_ptr,
         realm_collection_type_e collection_type,
         int64_t key_path_array_ptr,
-        jobject callback
+        jobject callback,
+        int32_t policy,
+        jlongArray out_subscription
 ) {
-    auto user_data = static_cast<jobject>(get_env()->NewGlobalRef(callback));
-    auto user_data_free = [](void *userdata) {
-        get_env(true)->DeleteGlobalRef(static_cast<jobject>(userdata));
-    };
-
     switch (collection_type) {
         case RLM_COLLECTION_TYPE_NONE:
-            return realm_object_add_notification_callback(
-                    reinterpret_cast<realm_object_t*>(collection_ptr),
-                    user_data, // Use the callback as user data
-                    user_data_free,
-                    (key_path_array_ptr == 0) ? NULL : reinterpret_cast<realm_key_path_array_t*>(key_path_array_ptr),
-                    get_on_object_change()
-            );
-        case RLM_COLLECTION_TYPE_LIST: return realm_list_add_notification_callback(
-                    reinterpret_cast<realm_list_t*>(collection_ptr),
-                    user_data, // Use the callback as user data
-                    user_data_free,
-                    reinterpret_cast<realm_key_path_array_t*>(key_path_array_ptr),
-                    get_on_collection_change()
-            );
-        case RLM_COLLECTION_TYPE_SET: return realm_set_add_notification_callback(
-                    reinterpret_cast<realm_set_t*>(collection_ptr),
-                    user_data, // Use the callback as user data
-                    user_data_free,
-                    reinterpret_cast<realm_key_path_array_t*>(key_path_array_ptr),
-                    get_on_collection_change()
-            );
-        case RLM_COLLECTION_TYPE_DICTIONARY: return realm_dictionary_add_notification_callback(
-                    reinterpret_cast<realm_dictionary_t*>(collection_ptr),
-                    user_data, // Use the callback as user data
-                    user_data_free,
-                    reinterpret_cast<realm_key_path_array_t*>(key_path_array_ptr),
-                    get_on_dictionary_change()
-            );
+            return add_notification_callback<realm_object_changes_t>(
+                    realm_object_add_notification_callback, collection_ptr,
+                    key_path_array_ptr, callback, policy, out_subscription);
+        case RLM_COLLECTION_TYPE_LIST:
+            return add_notification_callback<realm_collection_changes_t>(
+                    realm_list_add_notification_callback, collection_ptr,
+                    key_path_array_ptr, callback, policy, out_subscription);
+        case RLM_COLLECTION_TYPE_SET:
+            return add_notification_callback<realm_collection_changes_t>(
+                    realm_set_add_notification_callback, collection_ptr,
+                    key_path_array_ptr, callback, policy, out_subscription);
+        case RLM_COLLECTION_TYPE_DICTIONARY:
+            return add_notification_callback<realm_dictionary_changes_t>(
+                    realm_dictionary_add_notification_callback, collection_ptr,
+                    key_path_array_ptr, callback, policy, out_subscription);
     }
+    return nullptr;
 }
 
+// *** END - Notifications *** //
+
+// Number of notifications that were folded into an already pending upcall across all schedulers
+static std::atomic<int64_t> s_coalesced_notifications(0);
+
 class CustomJVMScheduler {
 public:
     CustomJVMScheduler(jobject dispatchScheduler) : m_id(std::this_thread::get_id()) {
@@ -303,18 +964,65 @@ public:
     }
 
     ~CustomJVMScheduler() {
+        // Work queues that were never drained because the scheduler was cancelled. Performing
+        // the work would release them, so they are released here instead.
+        release(m_pending);
         get_env(true)->DeleteGlobalRef(m_jvm_dispatch_scheduler);
     }
 
+    // Notifications are queued and only the notification finding the queue empty triggers an
+    // upcall. The single `drain` following that upcall then performs the work of all
+    // notifications received in the meantime. The queues keep their capacity, so notifying
+    // doesn't allocate once they have grown to the number of notifications of a drain.
     void notify(realm_work_queue_t* work_queue) {
+        PendingWork work{work_queue, NotificationTiming::notified(m_commits)};
+        bool was_empty;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            was_empty = m_pending.empty();
+            m_pending.push_back(work);
+        }
+        if (!was_empty) {
+            s_coalesced_notifications.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
         // There is currently no signaling of creation/tear down of the core notifier thread, so we
         // just attach it as a daemon thread here on first notification to allow the JVM to
         // shutdown property. See https://github.com/realm/realm-core/issues/6429
         auto jenv = get_env(true, true, "core-notifier");
         jni_check_exception(jenv);
         jenv->CallVoidMethod(m_jvm_dispatch_scheduler, m_notify_method,
-                             reinterpret_cast<jlong>(work_queue));
-        jni_check_exception(jenv);
+                             reinterpret_cast<jlong>(this));
+        if (!jni_check_exception(jenv)) {
+            // No drain will follow, so the queued work would never be performed and further
+            // notifications would only be added to it
+            std::vector<PendingWork> failed;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                failed.swap(m_pending);
+            }
+            release(failed);
+        }
+    }
+
+    void drain() {
+        // Taking the whole queue means that notifications arriving while performing the work find
+        // it empty and trigger a new upcall. The queue is handed back afterwards, so its capacity
+        // is reused by the next drain.
+        std::vector<PendingWork> pending;
+        pending.swap(m_drained);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            pending.swap(m_pending);
+        }
+        int64_t dispatched = monotonic_nanos();
+        for (auto& work : pending) {
+            work.timing.dispatched_nanos = dispatched;
+            s_latency[NOTIFY_TO_DISPATCH].record(dispatched - work.timing.notified_nanos);
+            perform_work(work.work_queue, &work.timing);
+        }
+        pending.clear();
+        m_drained.swap(pending);
     }
 
     bool is_on_thread() const noexcept {
@@ -325,6 +1033,10 @@ public:
         return true;
     }
 
+    void track_commits(const std::string& path) {
+        m_commits.bind(CommitClock::for_path(path));
+    }
+
     void cancel() {
         auto jenv = get_env(true, true, "core-notifier");
         jenv->CallVoidMethod(m_jvm_dispatch_scheduler, m_cancel_method);
@@ -333,12 +1045,44 @@ public:
 
 
 private:
+    struct PendingWork {
+        realm_work_queue_t* work_queue;
+        NotificationTiming timing;
+    };
+
+    static void release(std::vector<PendingWork>& pending) {
+        for (const auto& work : pending) {
+            realm_release(work.work_queue);
+        }
+        pending.clear();
+    }
+
     std::thread::id m_id;
     jmethodID m_notify_method;
     jmethodID m_cancel_method;
     jobject m_jvm_dispatch_scheduler;
+    std::mutex m_mutex;
+    // Guarded by `m_mutex`
+    std::vector<PendingWork> m_pending;
+    // Empty queue left by the last `drain`, only accessed on the thread of the scheduler
+    std::vector<PendingWork> m_drained;
+    CommitAttribution m_commits;
 };
 
+// Schedulers created by `realm_create_scheduler`, guarded by `jvm_schedulers_mutex`. The C-API
+// doesn't expose the userdata of a scheduler, so this maps them back to bind their commit clock.
+// Entries are removed when the scheduler is freed, while entries of released scheduler handles
+// are overwritten when the address is reused.
+static std::unordered_map<const realm_scheduler_t*, CustomJVMScheduler*>& jvm_schedulers() {
+    static std::unordered_map<const realm_scheduler_t*, CustomJVMScheduler*> schedulers;
+    return schedulers;
+}
+
+static std::mutex& jvm_schedulers_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
 // Note: using jlong here will create a linker issue
 // Undefined symbols for architecture x86_64:
 //  "invoke_core_notify_callback(long long, long long)", referenced from:
@@ -347,8 +1091,20 @@ private:
 //
 // I suspect this could be related to the fact that jni.h defines jlong differently between Android (typedef int64_t)
 // and JVM which is a (typedef long long) resulting in a different signature of the method that could be found by the linker.
-void invoke_core_notify_callback(int64_t work_queue) {
-    realm_scheduler_perform_work(reinterpret_cast<realm_work_queue_t *>(work_queue));
+void invoke_core_notify_callback(int64_t scheduler) {
+    reinterpret_cast<CustomJVMScheduler *>(scheduler)->drain();
+}
+
+int64_t realm_scheduler_coalesced_notifications() {
+    return s_coalesced_notifications.load(std::memory_order_relaxed);
+}
+
+jlongArray realm_jni_thread_stats() {
+    auto jenv = get_env(true);
+    jlong stats[] = { attached_thread_count(), detached_thread_count() };
+    jlongArray result = jenv->NewLongArray(2);
+    jenv->SetLongArrayRegion(result, 0, 2, stats);
+    return result;
 }
 
 realm_scheduler_t*
@@ -359,6 +1115,13 @@ realm_create_scheduler(jobject dispatchScheduler) {
                 jvmScheduler,
                 [](void *userdata) {
                     auto jvmScheduler = static_cast<CustomJVMScheduler *>(userdata);
+                    {
+                        std::lock_guard<std::mutex> lock(jvm_schedulers_mutex());
+                        auto& schedulers = jvm_schedulers();
+                        for (auto it = schedulers.begin(); it != schedulers.end();) {
+                            it = it->second == jvmScheduler ? schedulers.erase(it) : std::next(it);
+                        }
+                    }
                     jvmScheduler->cancel();
                     delete(jvmScheduler);
                 },
@@ -367,11 +1130,22 @@ realm_create_scheduler(jobject dispatchScheduler) {
                 [](const void *userdata, const void *userdata_other) { return userdata == userdata_other; },
                 [](void *userdata) { return static_cast<CustomJVMScheduler *>(userdata)->can_invoke(); }
         );
+        std::lock_guard<std::mutex> lock(jvm_schedulers_mutex());
+        jvm_schedulers()[scheduler] = jvmScheduler;
         return scheduler;
     }
     throw std::runtime_error("Null dispatchScheduler");
 }
 
+void
+realm_scheduler_track_commits(const realm_scheduler_t* scheduler, const realm_t* realm) {
+    std::lock_guard<std::mutex> lock(jvm_schedulers_mutex());
+    auto it = jvm_schedulers().find(scheduler);
+    if (it != jvm_schedulers().end()) {
+        it->second->track_commits((*realm)->config().path);
+    }
+}
+
 jobject convert_to_jvm_app_error(JNIEnv* env, const realm_app_error_t* error) {
     static JavaMethod app_error_constructor(env,
                                                 JavaClassGlobalDef::app_error(),
@@ -754,68 +1528,425 @@ realm_http_transport_t* realm_network_transport_new(jobject network_transport) {
 
 using WebsocketFunctionHandlerCallback = std::function<void(bool, int, const char*)>;
 
-static void websocket_post_func(realm_userdata_t userdata,
-                                realm_sync_socket_post_callback_t* realm_callback) {
-    // Some calls to 'post' happens from the external commit helper which is not necessarily attached yet to a JVM thread
-    auto jenv = get_env(true, true); // attach as daemon thread
-
-    WebsocketFunctionHandlerCallback* lambda = new WebsocketFunctionHandlerCallback([realm_callback=std::move(realm_callback)](bool cancelled, int status, const char* reason) {
-        realm_sync_socket_post_complete(realm_callback,
-                                        cancelled ? realm_sync_socket_callback_result::RLM_ERR_SYNC_SOCKET_OPERATION_ABORTED : realm_sync_socket_callback_result::RLM_ERR_SYNC_SOCKET_SUCCESS,
-                                        "");
-    });
+// Posts the handler to the event loop of the transport, which completes it through
+// `realm_sync_websocket_callback_complete`
+static void post_to_transport(JNIEnv* jenv, jobject websocket_transport,
+                              WebsocketFunctionHandlerCallback* lambda) {
     jobject lambda_callback_pointer_wrapper = wrap_pointer(jenv,reinterpret_cast<jlong>(lambda));
 
     static JavaMethod post_method(jenv, JavaClassGlobalDef::sync_websocket_transport(), "post",
                                                      "(Lio/realm/kotlin/internal/interop/NativePointer;)V");
-    jobject websocket_transport = static_cast<jobject>(userdata);
     jenv->CallVoidMethod(websocket_transport, post_method, lambda_callback_pointer_wrapper);
     jni_check_exception(jenv);
 
     jenv->DeleteLocalRef(lambda_callback_pointer_wrapper);
 }
 
-static realm_sync_socket_timer_t websocket_create_timer_func(
-        realm_userdata_t userdata, uint64_t delay_ms,
-        realm_sync_socket_timer_callback_t *realm_callback) {
-    // called from main thread/event loop which should be already attached to JVM
-    auto jenv = get_env(false);
+// Completes the handlers and timers of the sync client
+struct SyncClientCallbacks {
+    using Post = realm_sync_socket_post_callback_t;
+    using Timer = realm_sync_socket_timer_callback_t;
 
-    WebsocketFunctionHandlerCallback *lambda = new WebsocketFunctionHandlerCallback(
-            [realm_callback = std::move(realm_callback)](bool cancel, int status,
-                                                         const char *reason) {
-                if (cancel) {
-                    realm_sync_socket_timer_canceled(realm_callback);
-                } else {
-                    realm_sync_socket_timer_complete(realm_callback,
-                                                     realm_sync_socket_callback_result::RLM_ERR_SYNC_SOCKET_SUCCESS,
-                                                     "");
+    static void complete(Post* callback, bool cancelled) {
+        realm_sync_socket_post_complete(callback,
+                                        cancelled ? realm_sync_socket_callback_result::RLM_ERR_SYNC_SOCKET_OPERATION_ABORTED : realm_sync_socket_callback_result::RLM_ERR_SYNC_SOCKET_SUCCESS,
+                                        "");
+    }
+
+    static void complete(Timer* callback, bool cancelled) {
+        if (cancelled) {
+            realm_sync_socket_timer_canceled(callback);
+        } else {
+            realm_sync_socket_timer_complete(callback,
+                                             realm_sync_socket_callback_result::RLM_ERR_SYNC_SOCKET_SUCCESS,
+                                             "");
+        }
+    }
+};
+
+// Work of the sync client waiting for the event loop of the transport. Handlers posted by the sync
+// client are queued and timers are held in a hierarchical timing wheel, so posting a handler and
+// scheduling or cancelling a timer don't call into the JVM. A driver thread sleeps until handlers
+// have been posted or the next slot holding timers is due and then posts a single pass to the
+// event loop of the transport, which runs all queued handlers and completes all expired and
+// cancelled timers.
+//
+// The driver thread is used rather than waking the event loop directly, as handlers are also
+// posted from threads of Core that are not attached to the JVM, e.g. the external commit helper,
+// and as the event loop has no way of waiting for the next timer without an upcall for every
+// timer that becomes the earliest. The driver is the only thread calling into the JVM, and only
+// once per pass.
+//
+// The wheel has `LEVELS` levels of `SLOTS` slots, where each slot of level `n` spans `SLOTS^n`
+// ticks of a millisecond. Timers are placed in the lowest level whose range covers their delay and
+// are moved to lower levels when the wheel reaches their slot. Timers beyond the range of the
+// highest level are placed in its last slot and moved again once that is reached.
+//
+// Handlers and timers are completed through the static `complete` functions of `Callbacks`.
+template <typename Callbacks>
+class SyncEventQueue : public std::enable_shared_from_this<SyncEventQueue<Callbacks>> {
+public:
+    using PostCallback = typename Callbacks::Post;
+    using TimerCallback = typename Callbacks::Timer;
+
+    struct Timer {
+        Timer* prev = nullptr;
+        Timer* next = nullptr;
+        uint64_t deadline = 0;
+        // Level and slot of the timer or -1 if it isn't linked into the wheel
+        int level = -1;
+        int slot = -1;
+        TimerCallback* callback = nullptr;
+    };
+
+    explicit SyncEventQueue(jobject websocket_transport)
+        : m_websocket_transport(websocket_transport)
+        , m_start(std::chrono::steady_clock::now()) {
+    }
+
+    void start() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_thread = std::thread([self = this->shared_from_this()]() { self->run(); });
+    }
+
+    // Stops the driver thread and completes all handlers and timers that are still pending as
+    // cancelled
+    void close() {
+        std::vector<PostCallback*> posts;
+        std::vector<Completion> pending;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_closed) {
+                return;
+            }
+            m_closed = true;
+            for (auto& level : m_slots) {
+                for (auto& head : level) {
+                    while (head) {
+                        Timer* timer = head;
+                        unlink(timer);
+                        pending.push_back(Completion{timer->callback, true});
+                        timer->callback = nullptr;
+                    }
                 }
-            });
-    jobject lambda_callback_pointer_wrapper = wrap_pointer(jenv,reinterpret_cast<jlong>(lambda));
+            }
+            pending.insert(pending.end(), m_completions.begin(), m_completions.end());
+            m_completions.clear();
+            posts.swap(m_posts);
+        }
+        m_wakeup.notify_one();
+        if (m_thread.get_id() == std::this_thread::get_id()) {
+            m_thread.detach();
+        } else if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        for (auto callback : posts) {
+            Callbacks::complete(callback, true);
+        }
+        for (const auto& completion : pending) {
+            Callbacks::complete(completion.callback, true);
+        }
+    }
 
-    static JavaMethod create_timer_method (jenv, JavaClassGlobalDef::sync_websocket_transport(), "createTimer",
-                                                     "(JLio/realm/kotlin/internal/interop/NativePointer;)Lio/realm/kotlin/internal/interop/sync/CancellableTimer;");
-    jobject websocket_transport = static_cast<jobject>(userdata);
-    jobject cancellable_timer = jenv->CallObjectMethod(websocket_transport, create_timer_method, jlong(delay_ms), lambda_callback_pointer_wrapper);
-    jni_check_exception(jenv);
+    // Queues the handler to run on the event loop. Handlers run in the order they were posted.
+    void post(PostCallback* callback) {
+        bool closed;
+        bool wake_up = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            closed = m_closed;
+            if (!closed) {
+                m_posts.push_back(callback);
+                // Only the first handler of a pass needs to wake the driver
+                wake_up = !m_pass_pending && m_posts.size() == 1;
+            }
+        }
+        if (closed) {
+            Callbacks::complete(callback, true);
+        } else if (wake_up) {
+            m_wakeup.notify_one();
+        }
+    }
 
-    jenv->DeleteLocalRef(lambda_callback_pointer_wrapper);
-    return reinterpret_cast<realm_sync_socket_timer_t>(jenv->NewGlobalRef(cancellable_timer));
+    Timer* schedule(uint64_t delay_ms, TimerCallback* callback) {
+        Timer* timer = new Timer();
+        timer->callback = callback;
+        bool wake_up;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            timer->deadline = now() + delay_ms;
+            if (timer->deadline <= m_now) {
+                m_completions.push_back(Completion{callback, false});
+                timer->callback = nullptr;
+                wake_up = !m_pass_pending;
+            } else {
+                link(timer);
+                wake_up = timer->deadline < m_wake_at;
+            }
+        }
+        if (wake_up) {
+            m_wakeup.notify_one();
+        }
+        return timer;
+    }
+
+    void cancel(Timer* timer) {
+        bool wake_up = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // Already expired, cancelled or the wheel is closed
+            if (!timer->callback) {
+                return;
+            }
+            unlink(timer);
+            m_completions.push_back(Completion{timer->callback, true});
+            timer->callback = nullptr;
+            wake_up = !m_pass_pending;
+        }
+        if (wake_up) {
+            m_wakeup.notify_one();
+        }
+    }
+
+    void free(Timer* timer) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (timer->level >= 0) {
+                unlink(timer);
+            }
+        }
+        delete timer;
+    }
+
+private:
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+    static constexpr int LEVELS = 4;
+    static constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+
+    struct Completion {
+        TimerCallback* callback;
+        bool cancelled;
+    };
+
+    uint64_t now() const {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - m_start).count();
+    }
+
+    void link(Timer* timer) {
+        uint64_t delta = timer->deadline - m_now;
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+            ++level;
+        }
+        uint64_t position = timer->deadline;
+        uint64_t range = uint64_t(1) << (SLOT_BITS * LEVELS);
+        if (delta >= range) {
+            position = m_now + range - 1;
+        }
+        int slot = static_cast<int>((position >> (SLOT_BITS * level)) & SLOT_MASK);
+        Timer*& head = m_slots[level][slot];
+        timer->prev = nullptr;
+        timer->next = head;
+        if (head) {
+            head->prev = timer;
+        }
+        head = timer;
+        timer->level = level;
+        timer->slot = slot;
+        m_occupied[level] |= uint64_t(1) << slot;
+    }
+
+    void unlink(Timer* timer) {
+        Timer*& head = m_slots[timer->level][timer->slot];
+        if (timer->prev) {
+            timer->prev->next = timer->next;
+        } else {
+            head = timer->next;
+        }
+        if (timer->next) {
+            timer->next->prev = timer->prev;
+        }
+        if (!head) {
+            m_occupied[timer->level] &= ~(uint64_t(1) << timer->slot);
+        }
+        timer->prev = timer->next = nullptr;
+        timer->level = timer->slot = -1;
+    }
+
+    // The next tick after the current one at which a slot holding timers is reached
+    uint64_t next_event() const {
+        uint64_t next = NEVER;
+        for (int level = 0; level < LEVELS; ++level) {
+            uint64_t occupied = m_occupied[level];
+            if (!occupied) {
+                continue;
+            }
+            int shift = SLOT_BITS * level;
+            uint64_t current = (m_now >> shift) & SLOT_MASK;
+            // Distance to the first occupied slot after the current one, wrapping around to it
+            uint64_t distance = SLOTS;
+            for (uint64_t bits = occupied; bits; bits &= bits - 1) {
+                uint64_t slot = lowest_bit(bits);
+                distance = std::min(distance, ((slot - current - 1) & SLOT_MASK) + 1);
+            }
+            next = std::min(next, ((m_now >> shift) + distance) << shift);
+        }
+        return next;
+    }
+
+    static uint64_t lowest_bit(uint64_t bits) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return index;
+#else
+        return static_cast<uint64_t>(__builtin_ctzll(bits));
+#endif
+    }
+
+    // Advances the wheel to `to`, moving expired timers to the completions
+    void advance(uint64_t to) {
+        while (m_now < to) {
+            m_now = std::min(to, next_event());
+            for (int level = LEVELS - 1; level > 0; --level) {
+                if ((m_now & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) == 0) {
+                    cascade(level, static_cast<int>((m_now >> (SLOT_BITS * level)) & SLOT_MASK));
+                }
+            }
+            Timer*& head = m_slots[0][m_now & SLOT_MASK];
+            while (head) {
+                Timer* timer = head;
+                unlink(timer);
+                m_completions.push_back(Completion{timer->callback, false});
+                timer->callback = nullptr;
+            }
+        }
+    }
+
+    void cascade(int level, int slot) {
+        Timer* timer = m_slots[level][slot];
+        m_slots[level][slot] = nullptr;
+        m_occupied[level] &= ~(uint64_t(1) << slot);
+        while (timer) {
+            Timer* next = timer->next;
+            link(timer);
+            timer = next;
+        }
+    }
+
+    void run() {
+        JNIEnv* jenv = get_env(true, true, std::string("RealmSyncEvents"));
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_closed) {
+            if (!m_pass_pending) {
+                advance(now());
+                if (!m_completions.empty() || !m_posts.empty()) {
+                    m_pass_pending = true;
+                    lock.unlock();
+                    post_pass(jenv);
+                    lock.lock();
+                    continue;
+                }
+            }
+            m_wake_at = m_pass_pending ? NEVER : next_event();
+            if (m_wake_at == NEVER) {
+                m_wakeup.wait(lock);
+            } else {
+                m_wakeup.wait_until(lock, m_start + std::chrono::milliseconds(m_wake_at));
+            }
+        }
+        lock.unlock();
+        detach_current_thread();
+    }
+
+    void post_pass(JNIEnv* jenv) {
+        std::weak_ptr<SyncEventQueue> weak_queue = this->shared_from_this();
+        post_to_transport(jenv, m_websocket_transport, new WebsocketFunctionHandlerCallback(
+                [weak_queue](bool cancelled, int status, const char* reason) {
+                    if (auto queue = weak_queue.lock()) {
+                        queue->complete(cancelled);
+                    }
+                }));
+    }
+
+    // Runs on the event loop of the transport. If the transport is tearing down all handlers and
+    // timers are reported as cancelled. Handlers posted while running the pass are left for the
+    // next one.
+    void complete(bool cancelled) {
+        std::vector<PostCallback*> posts;
+        std::vector<Completion> completions;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            posts.swap(m_posts);
+            completions.swap(m_completions);
+            m_pass_pending = false;
+        }
+        m_wakeup.notify_one();
+        for (auto callback : posts) {
+            Callbacks::complete(callback, cancelled);
+        }
+        for (const auto& completion : completions) {
+            Callbacks::complete(completion.callback, completion.cancelled || cancelled);
+        }
+    }
+
+    jobject m_websocket_transport;
+    std::chrono::steady_clock::time_point m_start;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::array<std::array<Timer*, SLOTS>, LEVELS> m_slots{};
+    std::array<uint64_t, LEVELS> m_occupied{};
+    std::vector<PostCallback*> m_posts;
+    std::vector<Completion> m_completions;
+    uint64_t m_now = 0;
+    uint64_t m_wake_at = NEVER;
+    bool m_pass_pending = false;
+    bool m_closed = false;
+};
+
+using SyncClientEventQueue = SyncEventQueue<SyncClientCallbacks>;
+
+// Userdata of the sync socket
+struct SyncSocketProvider {
+    jobject websocket_transport;
+    std::shared_ptr<SyncClientEventQueue> events;
+};
+
+static jobject sync_socket_transport(realm_userdata_t userdata) {
+    return static_cast<SyncSocketProvider*>(userdata)->websocket_transport;
+}
+
+static void websocket_post_func(realm_userdata_t userdata,
+                                realm_sync_socket_post_callback_t* realm_callback) {
+    // Some calls to 'post' happen from the external commit helper, which doesn't need to be
+    // attached to the JVM as the handler is only queued
+    static_cast<SyncSocketProvider*>(userdata)->events->post(realm_callback);
+}
+
+static realm_sync_socket_timer_t websocket_create_timer_func(
+        realm_userdata_t userdata, uint64_t delay_ms,
+        realm_sync_socket_timer_callback_t *realm_callback) {
+    auto events = static_cast<SyncSocketProvider*>(userdata)->events;
+    return reinterpret_cast<realm_sync_socket_timer_t>(events->schedule(delay_ms, realm_callback));
 }
 
 static void websocket_cancel_timer_func(realm_userdata_t userdata,
                               realm_sync_socket_timer_t timer_userdata) {
     if (timer_userdata != nullptr) {
-        auto jenv = get_env(false);
-        jobject cancellable_timer = static_cast<jobject>(timer_userdata);
-
-        static JavaClass cancellable_timer_class(jenv, "io/realm/kotlin/internal/interop/sync/CancellableTimer");
-        static JavaMethod cancel_method(jenv, cancellable_timer_class, "cancel", "()V");
-        jenv->CallVoidMethod(cancellable_timer, cancel_method);
-        jni_check_exception(jenv);
+        auto events = static_cast<SyncSocketProvider*>(userdata)->events;
+        events->cancel(reinterpret_cast<SyncClientEventQueue::Timer*>(timer_userdata));
+    }
+}
 
-        jenv->DeleteGlobalRef(cancellable_timer);
+static void websocket_free_timer_func(realm_userdata_t userdata,
+                                      realm_sync_socket_timer_t timer_userdata) {
+    if (timer_userdata != nullptr) {
+        auto events = static_cast<SyncSocketProvider*>(userdata)->events;
+        events->free(reinterpret_cast<SyncClientEventQueue::Timer*>(timer_userdata));
     }
 }
 
@@ -834,7 +1965,7 @@ static realm_sync_socket_websocket_t websocket_connect_func(
 
     static JavaMethod connect_method(jenv, JavaClassGlobalDef::sync_websocket_transport(), "connect",
                                                         "(Lio/realm/kotlin/internal/interop/sync/WebSocketObserver;Ljava/lang/String;Ljava/lang/String;JZJLjava/lang/String;)Lio/realm/kotlin/internal/interop/sync/WebSocketClient;");
-    jobject websocket_transport = static_cast<jobject>(userdata);
+    jobject websocket_transport = sync_socket_transport(userdata);
 
     std::ostringstream supported_protocol;
     for (size_t i = 0; i < endpoint.num_protocols; ++i) {
@@ -859,12 +1990,103 @@ static realm_sync_socket_websocket_t websocket_connect_func(
     return global_websocket_ref;
 }
 
+// Pending write completions of frames sent through `ByteBufferWebSocketClient`. Writes are
+// identified by the index of their slot, which is recycled once the write completes, so sending a
+// frame does not allocate a completion handler.
+class WebSocketWritePool {
+public:
+    int64_t acquire(realm_sync_socket_write_callback_t* callback) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_free.empty()) {
+            m_callbacks.push_back(callback);
+            return static_cast<int64_t>(m_callbacks.size() - 1);
+        }
+        size_t slot = m_free.back();
+        m_free.pop_back();
+        m_callbacks[slot] = callback;
+        return static_cast<int64_t>(slot);
+    }
+
+    realm_sync_socket_write_callback_t* release(int64_t slot) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        realm_sync_socket_write_callback_t* callback = m_callbacks[slot];
+        m_callbacks[slot] = nullptr;
+        m_free.push_back(static_cast<size_t>(slot));
+        return callback;
+    }
+
+    // Number of slots, which only grows with the number of writes in flight at the same time
+    size_t size() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_callbacks.size();
+    }
+
+    size_t in_flight() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_callbacks.size() - m_free.size();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<realm_sync_socket_write_callback_t*> m_callbacks;
+    std::vector<size_t> m_free;
+};
+
+static WebSocketWritePool s_websocket_writes;
+
+// Completes a write handed to a `ByteBufferWebSocketClient` as failed. Writes of the test hooks
+// have no callback.
+static void websocket_write_failed(int64_t write_id, const char* reason) {
+    if (auto callback = s_websocket_writes.release(write_id)) {
+        realm_sync_socket_write_complete(callback,
+                                         realm_sync_socket_callback_result::RLM_ERR_SYNC_SOCKET_RUNTIME,
+                                         reason);
+    }
+}
+
+// The client gets a read-only direct buffer wrapping the frame held by Core instead of a copy. Core
+// frees the frame with the websocket, which can happen before the write completes, so the client
+// copies it before returning.
+static void websocket_write_direct(JNIEnv* jenv, jobject websocket_client,
+                                   const char* data, size_t size,
+                                   realm_sync_socket_write_callback_t* realm_callback) {
+    static JavaMethod send_method(jenv, JavaClassGlobalDef::sync_byte_buffer_websocket_client(),
+                                  "send", "(Ljava/nio/ByteBuffer;J)V");
+    static JavaMethod read_only_method(jenv, JavaClassGlobalDef::java_nio_byte_buffer(),
+                                       "asReadOnlyBuffer", "()Ljava/nio/ByteBuffer;");
+    int64_t write_id = s_websocket_writes.acquire(realm_callback);
+    jenv->PushLocalFrame(2);
+    // Core's frame is const, so the client only gets a read-only view of it
+    jobject buffer = jenv->NewDirectByteBuffer(const_cast<char*>(data), static_cast<jlong>(size));
+    if (buffer) {
+        buffer = jenv->CallObjectMethod(buffer, read_only_method);
+    }
+    if (!jni_check_exception(jenv) || !buffer) {
+        jenv->PopLocalFrame(nullptr);
+        websocket_write_failed(write_id, "Cannot create direct buffer");
+        return;
+    }
+    jenv->CallVoidMethod(websocket_client, send_method, buffer, jlong(write_id));
+    // The client does not complete writes it failed to send
+    if (!jni_check_exception(jenv)) {
+        websocket_write_failed(write_id, "Failed to send frame");
+    }
+    jenv->PopLocalFrame(nullptr);
+}
+
 static void websocket_async_write_func(realm_userdata_t userdata,
                                  realm_sync_socket_websocket_t websocket_userdata,
                                  const char* data, size_t size,
                                  realm_sync_socket_write_callback_t* realm_callback) {
     auto jenv = get_env(false);
 
+    if (jenv->IsInstanceOf(static_cast<jobject>(websocket_userdata),
+                           JavaClassGlobalDef::sync_byte_buffer_websocket_client())) {
+        websocket_write_direct(jenv, static_cast<jobject>(websocket_userdata), data, size,
+                               realm_callback);
+        return;
+    }
+
     WebsocketFunctionHandlerCallback* lambda = new WebsocketFunctionHandlerCallback([realm_callback=std::move(realm_callback)](bool cancelled, int status, const char* reason) {
         realm_sync_socket_write_complete(realm_callback,
                                          cancelled ? realm_sync_socket_callback_result::RLM_ERR_SYNC_SOCKET_OPERATION_ABORTED: realm_sync_socket_callback_result::RLM_ERR_SYNC_SOCKET_SUCCESS,
@@ -874,7 +2096,7 @@ static void websocket_async_write_func(realm_userdata_t userdata,
 
     static jmethodID write_method = jenv->GetMethodID(JavaClassGlobalDef::sync_websocket_transport(), "write",
                                                       "(Lio/realm/kotlin/internal/interop/sync/WebSocketClient;[BJLio/realm/kotlin/internal/interop/NativePointer;)V");
-    jobject websocket_transport = static_cast<jobject>(userdata);
+    jobject websocket_transport = sync_socket_transport(userdata);
 
     jbyteArray byteArray = jenv->NewByteArray(size);
     jenv->SetByteArrayRegion(byteArray, 0, size, reinterpret_cast<const jbyte*>(data));
@@ -908,14 +2130,17 @@ static void realm_sync_websocket_free(realm_userdata_t userdata,
 static void realm_sync_userdata_free(realm_userdata_t userdata) {
     if (userdata != nullptr) {
         auto jenv = get_env(false);
+        auto provider = static_cast<SyncSocketProvider*>(userdata);
+        provider->events->close();
 
         static jmethodID close_method = jenv->GetMethodID(JavaClassGlobalDef::sync_websocket_transport(), "close", "()V");
 
-        jobject websocket_transport = static_cast<jobject>(userdata);
+        jobject websocket_transport = provider->websocket_transport;
         jenv->CallVoidMethod(websocket_transport, close_method);
         jni_check_exception(jenv);
 
         jenv->DeleteGlobalRef(websocket_transport);
+        delete provider;
     }
 }
 
@@ -926,6 +2151,40 @@ void realm_sync_websocket_callback_complete(bool cancelled, int64_t lambda_ptr,
     delete callback;
 }
 
+void realm_sync_websocket_write_complete(int64_t write_id, bool cancelled) {
+    realm_sync_socket_write_callback_t* callback = s_websocket_writes.release(write_id);
+    // Writes of the test hooks have no callback
+    if (!callback) {
+        return;
+    }
+    realm_sync_socket_write_complete(callback,
+                                     cancelled ? realm_sync_socket_callback_result::RLM_ERR_SYNC_SOCKET_OPERATION_ABORTED : realm_sync_socket_callback_result::RLM_ERR_SYNC_SOCKET_SUCCESS,
+                                     "");
+}
+
+int64_t realm_sync_websocket_write_acquire_for_testing() {
+    return s_websocket_writes.acquire(nullptr);
+}
+
+void realm_sync_websocket_write_for_testing(jobject websocket_client, jbyteArray frame) {
+    auto jenv = get_env(false);
+    jsize size = jenv->GetArrayLength(frame);
+    std::vector<char> data(size);
+    jenv->GetByteArrayRegion(frame, 0, size, reinterpret_cast<jbyte*>(data.data()));
+    websocket_write_direct(jenv, websocket_client, data.data(), data.size(), nullptr);
+    // Core frees the frame once the write has been handed to the client, so clobber it before
+    // the client gets to send it
+    std::fill(data.begin(), data.end(), 0);
+}
+
+jlongArray realm_sync_websocket_write_pool_stats_for_testing() {
+    auto jenv = get_env(false);
+    jlong stats[] = { jlong(s_websocket_writes.size()), jlong(s_websocket_writes.in_flight()) };
+    jlongArray result = jenv->NewLongArray(2);
+    jenv->SetLongArrayRegion(result, 0, 2, stats);
+    return result;
+}
+
 void realm_sync_websocket_connected(int64_t observer_ptr, const char* protocol) {
     realm_sync_socket_websocket_connected(reinterpret_cast<realm_websocket_observer_t*>(observer_ptr), protocol);
 }
@@ -937,27 +2196,36 @@ void realm_sync_websocket_error(int64_t observer_ptr) {
 bool realm_sync_websocket_message(int64_t observer_ptr, jbyteArray data, size_t size) {
     auto jenv = get_env(false);
     jbyte* byteData = jenv->GetByteArrayElements(data, NULL);
-    std::unique_ptr<char[]> charData(new char[size]); // not null terminated (used in util::Span with size parameter)
-    std::memcpy(charData.get(), byteData, size);
-    bool close_websocket = !realm_sync_socket_websocket_message(reinterpret_cast<realm_websocket_observer_t*>(observer_ptr), charData.get(), size);
+    // Core only reads the message while handling it, so it can read the elements in place
+    bool close_websocket = !realm_sync_socket_websocket_message(reinterpret_cast<realm_websocket_observer_t*>(observer_ptr), reinterpret_cast<const char*>(byteData), size);
     jenv->ReleaseByteArrayElements(data, byteData, JNI_ABORT);
     return close_websocket;
 }
 
+bool realm_sync_websocket_message_direct(int64_t observer_ptr, jobject buffer, int64_t offset, int64_t size) {
+    auto jenv = get_env(false);
+    const char* data = direct_buffer_range(jenv, buffer, offset, size);
+    if (!data) {
+        return false;
+    }
+    return !realm_sync_socket_websocket_message(reinterpret_cast<realm_websocket_observer_t*>(observer_ptr), data, static_cast<size_t>(size));
+}
+
 void realm_sync_websocket_closed(int64_t observer_ptr, bool was_clean, int error_code, const char* reason) {
     realm_sync_socket_websocket_closed(reinterpret_cast<realm_websocket_observer_t*>(observer_ptr), was_clean, static_cast<realm_web_socket_errno_e>(error_code), reason);
 }
 
 realm_sync_socket_t* realm_sync_websocket_new(int64_t sync_client_config_ptr, jobject websocket_transport) {
     auto jenv = get_env(false); // Always called from JVM
-    realm_sync_socket_t* socket_provider = realm_sync_socket_new(jenv->NewGlobalRef(websocket_transport), /*userdata*/
+    jobject transport_ref = jenv->NewGlobalRef(websocket_transport);
+    auto events = std::make_shared<SyncClientEventQueue>(transport_ref);
+    events->start();
+    realm_sync_socket_t* socket_provider = realm_sync_socket_new(new SyncSocketProvider{transport_ref, events}, /*userdata*/
                                   realm_sync_userdata_free/*userdata_free*/,
                                   websocket_post_func/*post_func*/,
                                   websocket_create_timer_func/*create_timer_func*/,
                                   websocket_cancel_timer_func/*cancel_timer_func*/,
-                                  [](realm_userdata_t userdata,
-                                          realm_sync_socket_timer_t timer_userdata){
-                                  }/*free_timer_func*/,
+                                  websocket_free_timer_func/*free_timer_func*/,
                                   websocket_connect_func/*websocket_connect_func*/,
                                   websocket_async_write_func/*websocket_write_func*/,
                                   realm_sync_websocket_free/*websocket_free_func*/);
@@ -968,6 +2236,98 @@ realm_sync_socket_t* realm_sync_websocket_new(int64_t sync_client_config_ptr, jo
     return socket_provider;
 }
 
+// Records the completions of the handlers and timers of a test queue
+struct SyncEventRecorder {
+    std::mutex mutex;
+    // Pairs of the id of the handler or timer and whether it was cancelled
+    std::vector<jlong> completions;
+};
+
+struct RecordingCallbacks {
+    struct Recorded {
+        int64_t id;
+        std::shared_ptr<SyncEventRecorder> recorder;
+    };
+    using Post = Recorded;
+    using Timer = Recorded;
+
+    static void complete(Recorded* callback, bool cancelled) {
+        {
+            std::lock_guard<std::mutex> lock(callback->recorder->mutex);
+            callback->recorder->completions.push_back(callback->id);
+            callback->recorder->completions.push_back(cancelled ? 1 : 0);
+        }
+        delete callback;
+    }
+};
+
+using TestSyncEventQueue = SyncEventQueue<RecordingCallbacks>;
+
+struct TestSyncEventQueueHandle {
+    jobject websocket_transport;
+    std::shared_ptr<SyncEventRecorder> recorder;
+    std::shared_ptr<TestSyncEventQueue> queue;
+    std::vector<TestSyncEventQueue::Timer*> timers;
+};
+
+static TestSyncEventQueueHandle* test_sync_event_queue(int64_t queue) {
+    return reinterpret_cast<TestSyncEventQueueHandle*>(queue);
+}
+
+int64_t realm_sync_event_queue_new_for_testing(jobject websocket_transport) {
+    jobject transport_ref = get_env(false)->NewGlobalRef(websocket_transport);
+    auto handle = new TestSyncEventQueueHandle{transport_ref, std::make_shared<SyncEventRecorder>(),
+                                               std::make_shared<TestSyncEventQueue>(transport_ref), {}};
+    handle->queue->start();
+    return reinterpret_cast<int64_t>(handle);
+}
+
+void realm_sync_event_queue_post_for_testing(int64_t queue, int64_t id) {
+    auto handle = test_sync_event_queue(queue);
+    handle->queue->post(new RecordingCallbacks::Recorded{id, handle->recorder});
+}
+
+int64_t realm_sync_event_queue_schedule_for_testing(int64_t queue, int64_t delay_ms, int64_t id) {
+    auto handle = test_sync_event_queue(queue);
+    auto timer = handle->queue->schedule(static_cast<uint64_t>(delay_ms),
+                                         new RecordingCallbacks::Recorded{id, handle->recorder});
+    handle->timers.push_back(timer);
+    return reinterpret_cast<int64_t>(timer);
+}
+
+void realm_sync_event_queue_cancel_for_testing(int64_t queue, int64_t timer) {
+    test_sync_event_queue(queue)->queue->cancel(reinterpret_cast<TestSyncEventQueue::Timer*>(timer));
+}
+
+jlongArray realm_sync_event_queue_completions_for_testing(int64_t queue) {
+    auto recorder = test_sync_event_queue(queue)->recorder;
+    std::vector<jlong> completions;
+    {
+        std::lock_guard<std::mutex> lock(recorder->mutex);
+        completions.swap(recorder->completions);
+    }
+    auto jenv = get_env(true);
+    jsize size = static_cast<jsize>(completions.size());
+    jlongArray result = jenv->NewLongArray(size);
+    jenv->SetLongArrayRegion(result, 0, size, completions.data());
+    return result;
+}
+
+void realm_sync_event_queue_close_for_testing(int64_t queue) {
+    test_sync_event_queue(queue)->queue->close();
+}
+
+void realm_sync_event_queue_free_for_testing(int64_t queue) {
+    auto handle = test_sync_event_queue(queue);
+    handle->queue->close();
+    // Timers are freed by the sync client in the same way once they have been completed
+    for (auto timer : handle->timers) {
+        handle->queue->free(timer);
+    }
+    get_env(true)->DeleteGlobalRef(handle->websocket_transport);
+    delete handle;
+}
+
 // *** END - WebSocket Client (Platform Networking) *** //
 
 void set_log_callback(jobject log_callback) {
@@ -1317,25 +2677,6 @@ realm_sync_session_register_progress_notifier_wrapper(
     return jresult;
 }
 
-// Explicit clean up method for releasing heap allocated data of a realm_value_t instance
-void
-realm_value_t_cleanup(realm_value_t* value) {
-    switch (value->type) {
-        case RLM_TYPE_STRING:  {
-            const char* buf = value->string.data;
-            if (buf) delete buf;
-            break;
-        }
-        case RLM_TYPE_BINARY: {
-            const uint8_t* buf = value->binary.data;
-            if (buf) delete buf;
-            break;
-        }
-        default:
-            break;
-    }
-}
-
 void
 realm_sync_thread_created(realm_userdata_t userdata) {
     // Attach the sync client thread to the JVM so errors can be returned properly
@@ -1378,6 +2719,278 @@ realm_create_generic_scheduler() {
     return new realm_scheduler_t { realm::util::Scheduler::make_dummy() };
 }
 
+// *** BEGIN - Event loop *** //
+
+#if defined(__linux__)
+// Single native thread running an epoll loop that is woken through an eventfd. It executes both
+// the work queues of the core scheduler bound to it and runnables posted from the JVM, so realms
+// bound to it can be accessed on the loop thread and get their notifications delivered without
+// going through a coroutine dispatcher.
+class EventLoop : public std::enable_shared_from_this<EventLoop> {
+public:
+    EventLoop(std::string name, jobject executor) : m_name(std::move(name)) {
+        m_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (m_event_fd < 0 || m_epoll_fd < 0) {
+            close_fds();
+            throw std::runtime_error("Cannot create event loop");
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = m_event_fd;
+        if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_event_fd, &event) < 0) {
+            close_fds();
+            throw std::runtime_error("Cannot create event loop");
+        }
+        m_executor = get_env(true)->NewGlobalRef(executor);
+    }
+
+    ~EventLoop() {
+        // Only set if the loop thread never ran
+        if (m_executor) {
+            get_env(true)->DeleteGlobalRef(m_executor);
+        }
+        close_fds();
+    }
+
+    void start() {
+        // The thread keeps the loop alive until it has been stopped. Tasks are only taken under
+        // the lock, so the loop thread never observes an unassigned thread id.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_thread = std::thread([self = shared_from_this()]() { self->run(); });
+        m_thread_id = m_thread.get_id();
+    }
+
+    // Stops the loop and waits for the current task to complete. The loop thread then drains the
+    // pending tasks, see `drain`.
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopped) {
+                return;
+            }
+            m_stopped = true;
+        }
+        wake_up();
+        if (is_on_thread()) {
+            m_thread.detach();
+        } else {
+            m_thread.join();
+        }
+    }
+
+    void post(realm_work_queue_t* work_queue) {
+        if (!enqueue(Task{work_queue, nullptr})) {
+            // The loop thread is gone, so the work can no longer be performed on the thread of the
+            // realm
+            realm_release(work_queue);
+        }
+    }
+
+    void post(jobject runnable) {
+        jobject ref = get_env(true)->NewGlobalRef(runnable);
+        if (!enqueue(Task{nullptr, ref})) {
+            get_env(true)->DeleteGlobalRef(ref);
+        }
+    }
+
+    bool is_on_thread() const noexcept {
+        return m_thread_id == std::this_thread::get_id();
+    }
+
+private:
+    struct Task {
+        realm_work_queue_t* work_queue;
+        jobject runnable;
+    };
+
+    bool enqueue(Task task) {
+        bool was_empty;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopped) {
+                return false;
+            }
+            was_empty = m_tasks.empty();
+            m_tasks.push_back(task);
+        }
+        // Tasks are drained as a whole, so only the first task of a batch needs to wake the loop
+        if (was_empty) {
+            wake_up();
+        }
+        return true;
+    }
+
+    void wake_up() {
+        uint64_t one = 1;
+        // Can only fail if the counter overflows, which means that a wake up is already pending
+        ssize_t ignored = write(m_event_fd, &one, sizeof(one));
+        static_cast<void>(ignored);
+    }
+
+    void run() {
+        JNIEnv* jenv = get_env(true, true, m_name);
+        static jmethodID run_method = lookup(jenv, "java/lang/Runnable", "run", "()V");
+        std::vector<Task> tasks;
+        epoll_event event{};
+        while (true) {
+            int count = epoll_wait(m_epoll_fd, &event, 1, -1);
+            if (count < 0 && errno != EINTR) {
+                break;
+            }
+            uint64_t value;
+            ssize_t ignored = read(m_event_fd, &value, sizeof(value));
+            static_cast<void>(ignored);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_stopped) {
+                    break;
+                }
+                tasks.swap(m_tasks);
+            }
+            auto task = tasks.begin();
+            // A task can stop the loop, in which case the rest of the batch is drained with the
+            // pending tasks instead of touching what is being closed
+            for (; task != tasks.end() && !m_stopped.load(std::memory_order_acquire); ++task) {
+                if (task->work_queue) {
+                    perform_work(task->work_queue);
+                } else {
+                    jenv->CallVoidMethod(task->runnable, run_method);
+                    if (jenv->ExceptionCheck()) {
+                        // Dispatched coroutines handle their own failures, so just surface
+                        // anything else without taking down the loop
+                        jenv->ExceptionDescribe();
+                        jenv->ExceptionClear();
+                    }
+                    jenv->DeleteGlobalRef(task->runnable);
+                }
+            }
+            if (task != tasks.end()) {
+                // No tasks are added once the loop is stopped, so the remaining ones go first
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.insert(m_tasks.begin(), task, tasks.end());
+                break;
+            }
+            tasks.clear();
+        }
+        drain(jenv);
+        detach_current_thread();
+    }
+
+    // Completes the tasks that were still pending when the loop was stopped. Work queues are
+    // performed as they must run on the thread of their realm, while runnables are handed to the
+    // executor so blocks dispatched to the loop are neither lost nor delay closing it. No tasks
+    // are added once the loop is stopped.
+    void drain(JNIEnv* jenv) {
+        static jmethodID execute_method = lookup(jenv, "java/util/concurrent/Executor", "execute",
+                                                 "(Ljava/lang/Runnable;)V");
+        std::vector<Task> tasks;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            tasks.swap(m_tasks);
+        }
+        for (const auto& task : tasks) {
+            if (task.work_queue) {
+                perform_work(task.work_queue);
+            } else {
+                jenv->CallVoidMethod(m_executor, execute_method, task.runnable);
+                if (jenv->ExceptionCheck()) {
+                    jenv->ExceptionDescribe();
+                    jenv->ExceptionClear();
+                }
+                jenv->DeleteGlobalRef(task.runnable);
+            }
+        }
+        jenv->DeleteGlobalRef(m_executor);
+        m_executor = nullptr;
+    }
+
+    void close_fds() {
+        if (m_event_fd >= 0) ::close(m_event_fd);
+        if (m_epoll_fd >= 0) ::close(m_epoll_fd);
+    }
+
+    std::string m_name;
+    jobject m_executor = nullptr;
+    int m_event_fd = -1;
+    int m_epoll_fd = -1;
+    std::thread m_thread;
+    std::thread::id m_thread_id;
+    std::mutex m_mutex;
+    std::vector<Task> m_tasks;
+    // Only set under the lock, but also read by the loop thread between tasks
+    std::atomic<bool> m_stopped{false};
+};
+
+static std::shared_ptr<EventLoop>& event_loop(int64_t loop) {
+    return *reinterpret_cast<std::shared_ptr<EventLoop>*>(loop);
+}
+
+int64_t
+realm_event_loop_new(const char* name, jobject executor) {
+    try {
+        auto loop = std::make_shared<EventLoop>(name, executor);
+        loop->start();
+        return reinterpret_cast<int64_t>(new std::shared_ptr<EventLoop>(std::move(loop)));
+    } catch (std::exception&) {
+        return 0;
+    }
+}
+
+void
+realm_event_loop_post(int64_t loop, jobject runnable) {
+    event_loop(loop)->post(runnable);
+}
+
+void
+realm_event_loop_close(int64_t loop) {
+    auto handle = reinterpret_cast<std::shared_ptr<EventLoop>*>(loop);
+    (*handle)->stop();
+    delete handle;
+}
+
+realm_scheduler_t*
+realm_event_loop_scheduler(int64_t loop) {
+    return realm_scheduler_new(
+            new std::shared_ptr<EventLoop>(event_loop(loop)),
+            [](void* userdata) { delete static_cast<std::shared_ptr<EventLoop>*>(userdata); },
+            [](void* userdata, realm_work_queue_t* work_queue) {
+                (*static_cast<std::shared_ptr<EventLoop>*>(userdata))->post(work_queue);
+            },
+            [](void* userdata) {
+                return (*static_cast<std::shared_ptr<EventLoop>*>(userdata))->is_on_thread();
+            },
+            [](const void* userdata, const void* userdata_other) {
+                return static_cast<const std::shared_ptr<EventLoop>*>(userdata)->get() ==
+                       static_cast<const std::shared_ptr<EventLoop>*>(userdata_other)->get();
+            },
+            [](void*) { return true; }
+    );
+}
+#else
+int64_t
+realm_event_loop_new(const char*, jobject) {
+    return 0;
+}
+
+void
+realm_event_loop_post(int64_t, jobject) {
+    REALM_UNREACHABLE();
+}
+
+void
+realm_event_loop_close(int64_t) {
+    REALM_UNREACHABLE();
+}
+
+realm_scheduler_t*
+realm_event_loop_scheduler(int64_t) {
+    REALM_UNREACHABLE();
+}
+#endif
+
+// *** END - Event loop *** //
+
 void
 realm_property_info_t_cleanup(realm_property_info_t* value) {
     delete[] value->link_origin_property_name;
@@ -1392,6 +3005,17 @@ realm_class_info_t_cleanup(realm_class_info_t * value) {
     delete[] value->name;
 }
 
+jobjectArray realm_value_array_get_strings(realm_value_t* values, int64_t count) {
+    JNIEnv* env = get_env(true);
+    auto array = env->NewObjectArray(static_cast<jsize>(count), JavaClassGlobalDef::java_lang_string(), nullptr);
+    for (int64_t i = 0; i < count; i++) {
+        jstring string = to_jstring(env, StringData{values[i].string.data, values[i].string.size});
+        env->SetObjectArrayElement(array, static_cast<jsize>(i), string);
+        env->DeleteLocalRef(string);
+    }
+    return array;
+}
+
 jobjectArray realm_get_log_category_names() {
     JNIEnv* env = get_env(true);
 
@@ -1411,3 +3035,560 @@ jobjectArray realm_get_log_category_names() {
 
     return array;
 }
+
+// *** BEGIN - Packed values *** //
+
+namespace {
+// Values are packed into the buffer in native byte order as a sequence of 8-byte aligned records.
+// Each record starts with an 8-byte header holding the `realm_value_type_e` of the value and the
+// size of any variable length payload (strings and binaries), followed by the payload itself:
+//   NULL                   : <no payload>
+//   INT, BOOL              : int64
+//   FLOAT                  : float (padded to 8 bytes)
+//   DOUBLE                 : double
+//   TIMESTAMP              : int64 seconds, int32 nanoseconds (padded to 16 bytes)
+//   DECIMAL128             : 2 x uint64
+//   OBJECT_ID              : 12 bytes (padded to 16 bytes)
+//   UUID                   : 16 bytes
+//   LINK                   : int64 class key, int64 object key
+//   STRING, BINARY         : <size> bytes (padded to a multiple of 8 bytes)
+// Collections in mixed values are only represented by their header.
+class PackedValueWriter {
+public:
+    PackedValueWriter(char* buffer, size_t capacity) : m_buffer(buffer), m_capacity(capacity) {}
+
+    void write(const realm_value_t& value) {
+        switch (value.type) {
+            case RLM_TYPE_INT:
+                write_header(value.type);
+                put(value.integer);
+                break;
+            case RLM_TYPE_BOOL:
+                write_header(value.type);
+                put(int64_t(value.boolean ? 1 : 0));
+                break;
+            case RLM_TYPE_STRING:
+                write_header(value.type, value.string.size);
+                put(value.string.data, value.string.size);
+                break;
+            case RLM_TYPE_BINARY:
+                write_header(value.type, value.binary.size);
+                put(value.binary.data, value.binary.size);
+                break;
+            case RLM_TYPE_TIMESTAMP:
+                write_header(value.type);
+                put(value.timestamp.seconds);
+                put(value.timestamp.nanoseconds);
+                break;
+            case RLM_TYPE_FLOAT:
+                write_header(value.type);
+                put(value.fnum);
+                break;
+            case RLM_TYPE_DOUBLE:
+                write_header(value.type);
+                put(value.dnum);
+                break;
+            case RLM_TYPE_DECIMAL128:
+                write_header(value.type);
+                put(value.decimal128.w, sizeof(value.decimal128.w));
+                break;
+            case RLM_TYPE_OBJECT_ID:
+                write_header(value.type);
+                put(value.object_id.bytes, sizeof(value.object_id.bytes));
+                break;
+            case RLM_TYPE_UUID:
+                write_header(value.type);
+                put(value.uuid.bytes, sizeof(value.uuid.bytes));
+                break;
+            case RLM_TYPE_LINK:
+                write_header(value.type);
+                put(int64_t(value.link.target_table));
+                put(value.link.target);
+                break;
+            default:
+                write_header(value.type);
+                break;
+        }
+    }
+
+    // Number of bytes required to hold everything written so far. If this exceeds the capacity of
+    // the buffer the content of the buffer is incomplete and must be discarded.
+    size_t size() const {
+        return m_offset;
+    }
+
+private:
+    void write_header(realm_value_type_e type, size_t size = 0) {
+        int32_t header[2] = { static_cast<int32_t>(type), static_cast<int32_t>(size) };
+        put(header, sizeof(header));
+    }
+
+    template <typename T>
+    void put(T value) {
+        put(&value, sizeof(T));
+    }
+
+    void put(const void* data, size_t size) {
+        if (m_offset + size <= m_capacity && size > 0) {
+            memcpy(m_buffer + m_offset, data, size);
+        }
+        m_offset += (size + 7) & ~size_t(7);
+    }
+
+    char* m_buffer;
+    size_t m_capacity;
+    size_t m_offset = 0;
+};
+
+// Reads values written in the layout described for PackedValueWriter. Strings and binaries of the
+// returned values point directly into the buffer, so the buffer must outlive the values. Reading
+// past the end of the buffer throws an InvalidArgument error.
+class PackedValueReader {
+public:
+    PackedValueReader(const char* buffer, size_t size) : m_buffer(buffer), m_size(size) {}
+
+    realm_value_t read() {
+        int32_t header[2];
+        get(header, sizeof(header));
+        realm_value_t value;
+        value.type = static_cast<realm_value_type_e>(header[0]);
+        size_t size = static_cast<size_t>(header[1]);
+        switch (value.type) {
+            case RLM_TYPE_INT:
+                value.integer = get<int64_t>();
+                break;
+            case RLM_TYPE_BOOL:
+                value.boolean = get<int64_t>() != 0;
+                break;
+            case RLM_TYPE_STRING:
+                value.string = { m_buffer + m_offset, size };
+                skip(size);
+                break;
+            case RLM_TYPE_BINARY:
+                value.binary = { reinterpret_cast<const uint8_t*>(m_buffer + m_offset), size };
+                skip(size);
+                break;
+            case RLM_TYPE_TIMESTAMP:
+                value.timestamp.seconds = get<int64_t>();
+                value.timestamp.nanoseconds = get<int32_t>();
+                break;
+            case RLM_TYPE_FLOAT:
+                value.fnum = get<float>();
+                break;
+            case RLM_TYPE_DOUBLE:
+                value.dnum = get<double>();
+                break;
+            case RLM_TYPE_DECIMAL128:
+                get(value.decimal128.w, sizeof(value.decimal128.w));
+                break;
+            case RLM_TYPE_OBJECT_ID:
+                get(value.object_id.bytes, sizeof(value.object_id.bytes));
+                break;
+            case RLM_TYPE_UUID:
+                get(value.uuid.bytes, sizeof(value.uuid.bytes));
+                break;
+            case RLM_TYPE_LINK:
+                value.link.target_table = static_cast<realm_class_key_t>(get<int64_t>());
+                value.link.target = get<int64_t>();
+                break;
+            default:
+                break;
+        }
+        return value;
+    }
+
+    template <typename T>
+    T get() {
+        T value;
+        get(&value, sizeof(T));
+        return value;
+    }
+
+private:
+    void get(void* data, size_t size) {
+        check(size);
+        memcpy(data, m_buffer + m_offset, size);
+        skip(size);
+    }
+
+    void skip(size_t size) {
+        check(size);
+        m_offset += (size + 7) & ~size_t(7);
+    }
+
+    // The sizes of strings and binaries are read from the buffer, so they can't be trusted. The
+    // offset can be past the end after skipping the padding of the last payload.
+    void check(size_t size) const {
+        if (m_offset > m_size || size > m_size - m_offset) {
+            throw realm::InvalidArgument(realm::util::format("Packed value of %1 bytes at offset %2 is outside of buffer of %3 bytes",
+                                                             size, m_offset, m_size));
+        }
+    }
+
+    const char* m_buffer;
+    size_t m_size;
+    size_t m_offset = 0;
+};
+}
+
+int64_t
+realm_get_values_packed(realm_object_t* obj, jlongArray property_keys, jobject buffer) {
+    auto jenv = get_env(true);
+    jsize count = jenv->GetArrayLength(property_keys);
+    std::vector<realm_property_key_t> keys(count);
+    jenv->GetLongArrayRegion(property_keys, 0, count, reinterpret_cast<jlong*>(keys.data()));
+
+    std::vector<realm_value_t> values(count);
+    if (!realm_get_values(obj, count, keys.data(), values.data())) {
+        throw_last_error_as_java_exception(jenv);
+        return -1;
+    }
+
+    char* data = direct_buffer_range(jenv, buffer, 0, 0);
+    if (!data) {
+        throw_last_error_as_java_exception(jenv);
+        return -1;
+    }
+    PackedValueWriter writer(data, jenv->GetDirectBufferCapacity(buffer));
+    for (const auto& value : values) {
+        writer.write(value);
+    }
+    return writer.size();
+}
+
+int64_t
+realm_results_get_range(realm_results_t* results, int64_t from, int64_t count, jobject buffer) {
+    auto jenv = get_env(true);
+    char* data = direct_buffer_range(jenv, buffer, 0, 0);
+    if (!data) {
+        throw_last_error_as_java_exception(jenv);
+        return -1;
+    }
+    PackedValueWriter writer(data, jenv->GetDirectBufferCapacity(buffer));
+    realm_value_t value;
+    for (int64_t i = from; i < from + count; ++i) {
+        if (!realm_results_get(results, i, &value)) {
+            throw_last_error_as_java_exception(jenv);
+            return -1;
+        }
+        writer.write(value);
+    }
+    return writer.size();
+}
+
+namespace {
+// Reads the values of a single property of all objects of the results directly from the column of
+// the table, setting the bit of the corresponding element in the `nulls` bitmap for null values.
+template <typename Stored, typename T, typename JArray>
+bool get_results_column(realm_results_t* results, int64_t property_key, realm::ColumnType type,
+                        JArray values, jbyteArray nulls,
+                        void (JNIEnv::*set_region)(JArray, jsize, jsize, const T*)) {
+    auto jenv = get_env(true);
+    return realm::c_api::wrap_err([&]() {
+        realm::ColKey col_key(property_key);
+        if (results->get_type() != realm::PropertyType::Object) {
+            throw realm::InvalidArgument("Results must contain objects");
+        }
+        realm::ConstTableRef table = results->get_table();
+        if (!table || !table->valid_column(col_key) || col_key.is_collection() ||
+            col_key.get_type() != type) {
+            throw realm::InvalidArgument(realm::util::format(
+                    "Property key %1 is not a property of the requested type", property_key));
+        }
+        // Evaluates the results once, instead of resolving every element through the results
+        realm::TableView view = results->get_tableview();
+        size_t count = std::min(size_t(jenv->GetArrayLength(values)), view.size());
+        std::vector<T> column(count);
+        std::vector<jbyte> null_bits((count + 7) / 8);
+        for (size_t i = 0; i < count; ++i) {
+            auto value = view.get_object(i).template get<std::optional<Stored>>(col_key);
+            if (value) {
+                column[i] = T(*value);
+            } else {
+                null_bits[i / 8] |= jbyte(1 << (i % 8));
+            }
+        }
+        (jenv->*set_region)(values, 0, count, column.data());
+        jenv->SetByteArrayRegion(nulls, 0, null_bits.size(), null_bits.data());
+        return true;
+    });
+}
+}
+
+bool
+realm_results_get_long_column(realm_results_t* results, int64_t property_key, jlongArray values, jbyteArray nulls) {
+    return get_results_column<int64_t, jlong>(results, property_key, realm::col_type_Int, values, nulls,
+                                              &JNIEnv::SetLongArrayRegion);
+}
+
+bool
+realm_results_get_double_column(realm_results_t* results, int64_t property_key, jdoubleArray values, jbyteArray nulls) {
+    return get_results_column<double, jdouble>(results, property_key, realm::col_type_Double, values, nulls,
+                                               &JNIEnv::SetDoubleArrayRegion);
+}
+
+bool
+realm_results_get_float_column(realm_results_t* results, int64_t property_key, jfloatArray values, jbyteArray nulls) {
+    return get_results_column<float, jfloat>(results, property_key, realm::col_type_Float, values, nulls,
+                                             &JNIEnv::SetFloatArrayRegion);
+}
+
+bool
+realm_results_get_boolean_column(realm_results_t* results, int64_t property_key, jbooleanArray values, jbyteArray nulls) {
+    return get_results_column<bool, jboolean>(results, property_key, realm::col_type_Bool, values, nulls,
+                                              &JNIEnv::SetBooleanArrayRegion);
+}
+
+bool
+realm_set_values_packed(realm_object_t* obj, int64_t count, jobject buffer, int64_t size, bool is_default) {
+    auto jenv = get_env(true);
+    const char* data = direct_buffer_range(jenv, buffer, 0, size);
+    if (!data) {
+        return false;
+    }
+    PackedValueReader reader(data, size);
+    std::vector<realm_property_key_t> keys(count);
+    std::vector<realm_value_t> values(count);
+    bool read = realm::c_api::wrap_err([&]() {
+        for (int64_t i = 0; i < count; ++i) {
+            keys[i] = reader.get<int64_t>();
+            values[i] = reader.read();
+        }
+        return true;
+    });
+    if (!read) {
+        return false;
+    }
+    return realm_set_values(obj, count, keys.data(), values.data(), is_default);
+}
+
+// *** END - Packed values *** //
+
+// *** BEGIN - String views *** //
+
+jobject
+realm_get_string_view(realm_object_t* obj, int64_t property_key) {
+    auto jenv = get_env(true);
+    realm_value_t value;
+    if (!realm_get_value(obj, property_key, &value)) {
+        throw_last_error_as_java_exception(jenv);
+        return nullptr;
+    }
+    if (value.type == RLM_TYPE_NULL) {
+        return nullptr;
+    }
+    if (value.type != RLM_TYPE_STRING) {
+        realm::c_api::wrap_err([]() -> bool {
+            throw realm::InvalidArgument("Property is not a string property");
+        });
+        throw_last_error_as_java_exception(jenv);
+        return nullptr;
+    }
+    // Empty strings might not have any backing storage, but a direct buffer needs an address
+    static char empty = 0;
+    void* data = value.string.size ? const_cast<char*>(value.string.data) : &empty;
+    return jenv->NewDirectByteBuffer(data, value.string.size);
+}
+
+// *** END - String views *** //
+
+// *** BEGIN - Value slab *** //
+
+int64_t
+realm_value_slab(int64_t capacity) {
+    // Released by the C++ runtime when the thread terminates, which is after the last JVM code
+    // using the slots has run.
+    thread_local std::vector<realm_value_t> slab;
+    if (slab.size() < static_cast<size_t>(capacity)) {
+        slab.resize(capacity);
+    }
+    return reinterpret_cast<int64_t>(slab.data());
+}
+
+int64_t
+realm_value_t_size() {
+    return sizeof(realm_value_t);
+}
+
+// *** END - Value slab *** //
+
+// *** BEGIN - Value arena *** //
+
+namespace {
+// Chunked bump allocator for the string and binary buffers of values passed to the C-API through
+// a MemTrackingAllocator. All buffers are released at once when the allocator is freed.
+class ValueArena {
+public:
+    static constexpr size_t chunk_size = 16 * 1024;
+
+    char* allocate(size_t size) {
+        if (size > chunk_size / 4) {
+            m_large.emplace_back(new char[size]);
+            return m_large.back().get();
+        }
+        if (m_chunks.empty() || chunk_size - m_used < size) {
+            m_chunks.emplace_back(new char[chunk_size]);
+            m_used = 0;
+        }
+        char* data = m_chunks.back().get() + m_used;
+        m_used += size;
+        return data;
+    }
+
+private:
+    std::vector<std::unique_ptr<char[]>> m_chunks;
+    std::vector<std::unique_ptr<char[]>> m_large;
+    size_t m_used = 0;
+};
+} // anonymous namespace
+
+int64_t
+realm_value_arena_new() {
+    return reinterpret_cast<int64_t>(new ValueArena());
+}
+
+void
+realm_value_arena_free(int64_t arena) {
+    delete reinterpret_cast<ValueArena*>(arena);
+}
+
+void
+realm_value_set_string(realm_value_t* value, realm_string_t str, int64_t arena) {
+    char* data = reinterpret_cast<ValueArena*>(arena)->allocate(str.size);
+    std::memcpy(data, str.data, str.size);
+    value->type = RLM_TYPE_STRING;
+    value->string = realm_string_t{data, str.size};
+}
+
+void
+realm_value_set_binary(realm_value_t* value, jbyteArray bytes, int64_t arena) {
+    auto jenv = get_env(true);
+    jsize size = jenv->GetArrayLength(bytes);
+    char* data = reinterpret_cast<ValueArena*>(arena)->allocate(size);
+    jenv->GetByteArrayRegion(bytes, 0, size, reinterpret_cast<jbyte*>(data));
+    value->type = RLM_TYPE_BINARY;
+    value->binary = realm_binary_t{reinterpret_cast<const uint8_t*>(data), static_cast<size_t>(size)};
+}
+
+// *** END - Value arena *** //
+
+// *** BEGIN - Fixed size values *** //
+
+void
+realm_value_set_object_id(realm_value_t* value, jbyteArray bytes) {
+    auto jenv = get_env(true);
+    value->type = RLM_TYPE_OBJECT_ID;
+    jenv->GetByteArrayRegion(bytes, 0, sizeof(value->object_id.bytes),
+                             reinterpret_cast<jbyte*>(value->object_id.bytes));
+}
+
+void
+realm_value_set_uuid(realm_value_t* value, jbyteArray bytes) {
+    auto jenv = get_env(true);
+    value->type = RLM_TYPE_UUID;
+    jenv->GetByteArrayRegion(bytes, 0, sizeof(value->uuid.bytes),
+                             reinterpret_cast<jbyte*>(value->uuid.bytes));
+}
+
+void
+realm_value_set_decimal128(realm_value_t* value, int64_t low, int64_t high) {
+    value->type = RLM_TYPE_DECIMAL128;
+    value->decimal128.w[0] = static_cast<uint64_t>(low);
+    value->decimal128.w[1] = static_cast<uint64_t>(high);
+}
+
+jbyteArray
+realm_value_get_object_id(realm_value_t* value) {
+    auto jenv = get_env(true);
+    jbyteArray bytes = jenv->NewByteArray(sizeof(value->object_id.bytes));
+    jenv->SetByteArrayRegion(bytes, 0, sizeof(value->object_id.bytes),
+                             reinterpret_cast<const jbyte*>(value->object_id.bytes));
+    return bytes;
+}
+
+jbyteArray
+realm_value_get_uuid(realm_value_t* value) {
+    auto jenv = get_env(true);
+    jbyteArray bytes = jenv->NewByteArray(sizeof(value->uuid.bytes));
+    jenv->SetByteArrayRegion(bytes, 0, sizeof(value->uuid.bytes),
+                             reinterpret_cast<const jbyte*>(value->uuid.bytes));
+    return bytes;
+}
+
+void
+realm_value_get_decimal128(realm_value_t* value, jlongArray words) {
+    auto jenv = get_env(true);
+    jenv->SetLongArrayRegion(words, 0, 2, reinterpret_cast<const jlong*>(value->decimal128.w));
+}
+
+// *** END - Fixed size values *** //
+
+// *** BEGIN - Change sets *** //
+
+jintArray
+realm_collection_changes_get_flattened(realm_collection_changes_t* changes) {
+    auto jenv = get_env(true);
+
+    size_t num_deletions, num_insertions, num_modifications, num_moves;
+    bool was_cleared, was_deleted;
+    realm_collection_changes_get_num_changes(changes, &num_deletions, &num_insertions,
+                                             &num_modifications, &num_moves,
+                                             &was_cleared, &was_deleted);
+    size_t num_deletion_ranges, num_insertion_ranges, num_modification_ranges, num_range_moves;
+    realm_collection_changes_get_num_ranges(changes, &num_deletion_ranges, &num_insertion_ranges,
+                                            &num_modification_ranges, &num_range_moves);
+
+    std::vector<size_t> indices(num_deletions + num_insertions + 2 * num_modifications);
+    size_t* deletions = indices.data();
+    size_t* insertions = deletions + num_deletions;
+    size_t* modifications = insertions + num_insertions;
+    size_t* modifications_after = modifications + num_modifications;
+    std::vector<realm_collection_move_t> moves(num_moves);
+    realm_collection_changes_get_changes(changes,
+                                         deletions, num_deletions,
+                                         insertions, num_insertions,
+                                         modifications, num_modifications,
+                                         modifications_after, num_modifications,
+                                         moves.data(), num_moves);
+
+    std::vector<realm_index_range_t> ranges(num_deletion_ranges + num_insertion_ranges + 2 * num_modification_ranges);
+    realm_index_range_t* deletion_ranges = ranges.data();
+    realm_index_range_t* insertion_ranges = deletion_ranges + num_deletion_ranges;
+    realm_index_range_t* modification_ranges = insertion_ranges + num_insertion_ranges;
+    realm_index_range_t* modification_ranges_after = modification_ranges + num_modification_ranges;
+    realm_collection_changes_get_ranges(changes,
+                                        deletion_ranges, num_deletion_ranges,
+                                        insertion_ranges, num_insertion_ranges,
+                                        modification_ranges, num_modification_ranges,
+                                        modification_ranges_after, num_modification_ranges,
+                                        nullptr, 0);
+
+    // Must match the layout read by `initFromFlattened` in ListChangeSetBuilderExt.kt
+    std::vector<jint> flattened;
+    flattened.reserve(8 + indices.size() + 2 * (moves.size() + ranges.size()));
+    flattened.push_back((was_cleared ? 1 : 0) | (was_deleted ? 2 : 0));
+    flattened.push_back(static_cast<jint>(num_deletions));
+    flattened.push_back(static_cast<jint>(num_insertions));
+    flattened.push_back(static_cast<jint>(num_modifications));
+    flattened.push_back(static_cast<jint>(num_moves));
+    flattened.push_back(static_cast<jint>(num_deletion_ranges));
+    flattened.push_back(static_cast<jint>(num_insertion_ranges));
+    flattened.push_back(static_cast<jint>(num_modification_ranges));
+    for (size_t index : indices) {
+        flattened.push_back(static_cast<jint>(index));
+    }
+    for (const auto& move : moves) {
+        flattened.push_back(static_cast<jint>(move.from));
+        flattened.push_back(static_cast<jint>(move.to));
+    }
+    for (const auto& range : ranges) {
+        flattened.push_back(static_cast<jint>(range.from));
+        flattened.push_back(static_cast<jint>(range.to));
+    }
+
+    jintArray result = jenv->NewIntArray(static_cast<jsize>(flattened.size()));
+    jenv->SetIntArrayRegion(result, 0, static_cast<jsize>(flattened.size()), flattened.data());
+    return result;
+}
+
+// *** END - Change sets *** //
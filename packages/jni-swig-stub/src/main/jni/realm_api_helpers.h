@@ -34,18 +34,65 @@ bool
 migration_callback(void* userdata, realm_t* old_realm, realm_t* new_realm,
                    const realm_schema_t* schema);
 
+// Registers a notification callback on results. `policy` is one of the `NotificationPolicy` values
+// and the address of the registration is stored in `out_subscription` if given.
 realm_notification_token_t*
 register_results_notification_cb(
         realm_results_t *results,
         int64_t key_path_array_ptr,
-        jobject callback);
+        jobject callback,
+        int32_t policy,
+        jlongArray out_subscription);
 
+// Enables or disables delivering all notifications triggered by performing the work of a scheduler
+// in a single upcall to the JVM. Enabled by default.
+void
+realm_set_batched_notifications(bool enabled);
+
+// Registers a notification callback on an object or collection. Notifications without any changes
+// are not delivered apart from the initial one. `policy` and `out_subscription` are the same as for
+// `register_results_notification_cb`.
 realm_notification_token_t *
 register_notification_cb(
         int64_t collection_ptr,
         realm_collection_type_e collection_type,
         int64_t key_path_array_ptr,
-        jobject callback);
+        jobject callback,
+        int32_t policy,
+        jlongArray out_subscription);
+
+// Signals that the receiver of a registration with the MERGE policy is ready for the next change.
+// Delivers the pending change, if any. Must be called on the thread delivering the notifications
+// and only while the registration is still active.
+void
+realm_notification_ready(int64_t subscription);
+
+// Number of changes merged into a pending change by registrations with the MERGE policy
+int64_t
+realm_merged_notifications();
+
+// Commits the write transaction like `realm_commit`, recording the time of the commit to measure
+// the latency of the notifications triggered by it
+bool
+realm_commit_tracked(realm_t* realm);
+
+// Returns summaries of the notification latency histograms. The array holds a summary for each
+// `LatencyStage` followed by the id and commit to callback summary of every registration notified
+// about a commit. Each summary consists of the count, min, max, mean, p50, p90, p99 and p99.9.
+jlongArray
+realm_notification_latency_stats();
+
+// Resolves the key paths of a class into a key path array shared with all other registrations on
+// the same realm file and schema version observing the same key paths. Returns a reference to the
+// array, which must be passed as `key_path_array_ptr` to the notification registrations and is
+// released through `realm_release`.
+int64_t
+realm_key_path_array_cached(const realm_t* realm, int64_t class_key, size_t num_key_paths,
+                            char** key_paths);
+
+// Whether two references returned by `realm_key_path_array_cached` share the same array
+bool
+realm_key_path_arrays_shared_for_testing(int64_t key_path_array_ptr, int64_t other_ptr);
 
 realm_http_transport_t*
 realm_network_transport_new(jobject network_transport);
@@ -56,6 +103,11 @@ set_log_callback(jobject log_callback);
 realm_scheduler_t*
 realm_create_scheduler(jobject dispatchScheduler);
 
+// Attributes commits on the file of the realm to the notifications of the scheduler when measuring
+// the notification latency. Only has an effect on schedulers created by `realm_create_scheduler`.
+void
+realm_scheduler_track_commits(const realm_scheduler_t* scheduler, const realm_t* realm);
+
 bool
 realm_should_compact_callback(void* userdata, uint64_t total_bytes, uint64_t used_bytes);
 
@@ -63,7 +115,16 @@ bool
 realm_data_initialization_callback(void* userdata, realm_t* realm);
 
 void
-invoke_core_notify_callback(int64_t core_notify_function);
+invoke_core_notify_callback(int64_t scheduler);
+
+// Number of scheduler notifications that did not cause an upcall to the JVM because one was
+// already pending.
+int64_t
+realm_scheduler_coalesced_notifications();
+
+// Returns the number of threads attached to and detached from the JVM by the native layer
+jlongArray
+realm_jni_thread_stats();
 
 void
 app_complete_void_callback(void* userdata, const realm_app_error_t* error);
@@ -112,10 +173,6 @@ realm_sync_session_progress_notifier_callback(void *userdata, uint64_t, uint64_t
 void
 realm_sync_session_connection_state_change_callback(void *userdata, realm_sync_connection_state_e old_state, realm_sync_connection_state_e new_state);
 
-// Explicit clean up method for releasing heap allocated data of a realm_value_t instance
-void
-realm_value_t_cleanup(realm_value_t* value);
-
 void
 app_apikey_callback(realm_userdata_t userdata, realm_app_user_apikey_t*, const realm_app_error_t*);
 
@@ -143,6 +200,25 @@ realm_sync_thread_error(realm_userdata_t userdata, const char* error);
 realm_scheduler_t*
 realm_create_generic_scheduler();
 
+// Native event loop running on a dedicated thread. Runnables still pending when the loop is closed
+// are handed to `executor`. Only available on Linux, returns 0 if the loop could not be created.
+int64_t
+realm_event_loop_new(const char* name, jobject executor);
+
+// Runs the runnable on the loop thread
+void
+realm_event_loop_post(int64_t loop, jobject runnable);
+
+// Stops the loop and releases the handle. Pending work of schedulers created from the loop is
+// still performed on the loop thread before it exits. The schedulers stay valid, but do not deliver
+// any further notifications.
+void
+realm_event_loop_close(int64_t loop);
+
+// Scheduler performing its work on the loop thread
+realm_scheduler_t*
+realm_event_loop_scheduler(int64_t loop);
+
 void
 realm_property_info_t_cleanup(realm_property_info_t* value);
 
@@ -153,14 +229,141 @@ realm_sync_socket_t* realm_sync_websocket_new(int64_t sync_client_config_ptr, jo
 
 void realm_sync_websocket_callback_complete(bool cancelled, int64_t lambda_ptr, int status, const char* reason);
 
+// Event queue of the sync socket posting its passes to `websocket_transport`, which records the
+// completions of handlers and timers identified by an id instead of completing them for the sync
+// client. Only used to test the queue.
+int64_t realm_sync_event_queue_new_for_testing(jobject websocket_transport);
+
+void realm_sync_event_queue_post_for_testing(int64_t queue, int64_t id);
+
+// Returns the timer to cancel it with
+int64_t realm_sync_event_queue_schedule_for_testing(int64_t queue, int64_t delay_ms, int64_t id);
+
+void realm_sync_event_queue_cancel_for_testing(int64_t queue, int64_t timer);
+
+// Returns the handlers and timers completed since the last call as pairs of the id and 1 if it was
+// cancelled or 0 otherwise
+jlongArray realm_sync_event_queue_completions_for_testing(int64_t queue);
+
+// Completes all pending handlers and timers as cancelled
+void realm_sync_event_queue_close_for_testing(int64_t queue);
+
+// Closes the queue and frees it along with its timers
+void realm_sync_event_queue_free_for_testing(int64_t queue);
+
+// Completes a write of a frame sent through `ByteBufferWebSocketClient.send`. Like the completion of
+// other writes, the result is only reported as aborted or successful.
+void realm_sync_websocket_write_complete(int64_t write_id, bool cancelled);
+
+// Acquires a write without a callback, which is only released when completed
+int64_t realm_sync_websocket_write_acquire_for_testing();
+
+// Sends the frame through `ByteBufferWebSocketClient.send` as a write without a callback, and
+// clobbers the frame as soon as the call returns
+void realm_sync_websocket_write_for_testing(jobject websocket_client, jbyteArray frame);
+
+// Returns the number of slots of the pending writes and the number of writes in flight
+jlongArray realm_sync_websocket_write_pool_stats_for_testing();
+
 void realm_sync_websocket_connected(int64_t observer_ptr, const char* protocol);
 
 void realm_sync_websocket_error(int64_t observer_ptr);
 
 bool realm_sync_websocket_message(int64_t observer_ptr, jbyteArray data, size_t size);
 
+// Same as `realm_sync_websocket_message` for a message of `size` bytes starting at `offset` in a
+// direct byte buffer. The message is read in place and not referenced after returning.
+bool realm_sync_websocket_message_direct(int64_t observer_ptr, jobject buffer, int64_t offset, int64_t size);
+
 void realm_sync_websocket_closed(int64_t observer_ptr, bool was_clean, int error_code, const char* reason);
 
 jobjectArray realm_get_log_category_names();
 
+// Reads the string values of an array of `count` values without copying the structs to the JVM
+jobjectArray realm_value_array_get_strings(realm_value_t* values, int64_t count);
+
+// Packs the values of the given properties into a direct byte buffer. Returns the number of bytes
+// needed to hold all values; if larger than the buffer capacity the buffer content is incomplete.
+int64_t
+realm_get_values_packed(realm_object_t* obj, jlongArray property_keys, jobject buffer);
+
+// Packs `count` elements of the results starting at index `from` into a direct byte buffer.
+// Returns the number of bytes needed like `realm_get_values_packed`.
+int64_t
+realm_results_get_range(realm_results_t* results, int64_t from, int64_t count, jobject buffer);
+
+// Reads the values of a single property of all objects of the results into a primitive array.
+// Null values are flagged in the `nulls` bitmap holding one bit per element.
+bool
+realm_results_get_long_column(realm_results_t* results, int64_t property_key, jlongArray values, jbyteArray nulls);
+
+bool
+realm_results_get_double_column(realm_results_t* results, int64_t property_key, jdoubleArray values, jbyteArray nulls);
+
+bool
+realm_results_get_float_column(realm_results_t* results, int64_t property_key, jfloatArray values, jbyteArray nulls);
+
+bool
+realm_results_get_boolean_column(realm_results_t* results, int64_t property_key, jbooleanArray values, jbyteArray nulls);
+
+// Sets the values of multiple properties from a direct byte buffer holding `count` records, each
+// consisting of the property key followed by the packed value.
+bool
+realm_set_values_packed(realm_object_t* obj, int64_t count, jobject buffer, int64_t size, bool is_default);
+
+// Returns a direct byte buffer referencing the UTF-8 bytes of a string property in the Realm file
+// without copying them, or null if the value is null. The buffer is only valid as long as the
+// version of the object stays available.
+jobject
+realm_get_string_view(realm_object_t* obj, int64_t property_key);
+
+// Returns the address of the calling thread's slab of at least `capacity` realm_value_t slots. The
+// slab is reused across calls and only valid on the calling thread.
+int64_t
+realm_value_slab(int64_t capacity);
+
+int64_t
+realm_value_t_size();
+
+// Arena holding the string and binary buffers of values passed to the C-API. Buffers are only
+// released when the whole arena is freed.
+int64_t
+realm_value_arena_new();
+
+void
+realm_value_arena_free(int64_t arena);
+
+// Sets the value to a copy of the string, allocated in the arena
+void
+realm_value_set_string(realm_value_t* value, realm_string_t str, int64_t arena);
+
+// Sets the value to a copy of the bytes, allocated in the arena
+void
+realm_value_set_binary(realm_value_t* value, jbyteArray bytes, int64_t arena);
+
+// Accessors for fixed size values that move the raw bytes or words in a single call instead of
+// going through the element wise accessors of the generated struct proxies.
+void
+realm_value_set_object_id(realm_value_t* value, jbyteArray bytes);
+
+void
+realm_value_set_uuid(realm_value_t* value, jbyteArray bytes);
+
+void
+realm_value_set_decimal128(realm_value_t* value, int64_t low, int64_t high);
+
+jbyteArray
+realm_value_get_object_id(realm_value_t* value);
+
+jbyteArray
+realm_value_get_uuid(realm_value_t* value);
+
+void
+realm_value_get_decimal128(realm_value_t* value, jlongArray words);
+
+// Flattens all indices, moves and ranges of a collection change set into a single int array, see
+// `initFromFlattened` in ListChangeSetBuilderExt.kt for the layout.
+jintArray
+realm_collection_changes_get_flattened(realm_collection_changes_t* changes);
+
 #endif //TEST_REALM_API_HELPERS_H
@@ -28,6 +28,9 @@
 -keep class io.realm.kotlin.internal.interop.NotificationCallback {
     *;
 }
+-keep class io.realm.kotlin.internal.interop.NotificationMultiplexer {
+    *;
+}
 # Utils to convert core errors into Kotlin exceptions
 -keep class io.realm.kotlin.internal.interop.CoreErrorConverter {
     *;
@@ -137,6 +140,9 @@
 -keep class io.realm.kotlin.internal.interop.sync.WebSocketClient {
     *;
 }
+-keep class io.realm.kotlin.internal.interop.sync.ByteBufferWebSocketClient {
+    *;
+}
 -keep class io.realm.kotlin.internal.interop.sync.WebSocketObserver {
     *;
 }
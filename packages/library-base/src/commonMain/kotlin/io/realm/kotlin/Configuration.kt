@@ -24,6 +24,7 @@ import io.realm.kotlin.internal.realmObjectCompanionOrNull
 import io.realm.kotlin.types.BaseRealmObject
 import kotlinx.coroutines.CoroutineDispatcher
 import kotlin.reflect.KClass
+import kotlin.time.Duration
 
 /**
  * This interface is used to determine if a Realm file should be compacted the first time the file
@@ -209,6 +210,9 @@ public interface Configuration {
         protected var initialDataCallback: InitialDataCallback? = null
         protected var inMemory: Boolean = false
         protected var initialRealmFileConfiguration: InitialRealmFileConfiguration? = null
+        protected var coalesceNotifications: Boolean = false
+        protected var maxWriteGroupSize: Int = 1
+        protected var maxWriteGroupDuration: Duration = Duration.ZERO
 
         /**
          * Sets the filename of the realm file.
@@ -283,6 +287,46 @@ public interface Configuration {
             this.writeDispatcher = dispatcher
         } as S
 
+        /**
+         * Merges changes to objects and collections observed through flows while a collector is
+         * still processing a previous change. Slow collectors will then receive a single change
+         * spanning all versions that were committed in the meantime instead of one change per
+         * version. Dictionary changes are never merged.
+         *
+         * Merging changes keeps a slow collector from pinning a version of the realm for every
+         * change it has not processed yet, which would otherwise grow the realm file.
+         *
+         * Only supported on JVM and Android, other platforms always deliver all changes.
+         *
+         * @param enabled whether changes should be merged.
+         */
+        public fun coalesceNotifications(enabled: Boolean): S = apply {
+            this.coalesceNotifications = enabled
+        } as S
+
+        /**
+         * Commits concurrent writes together in a single transaction. Writes submitted while a
+         * transaction is running are queued and then run back-to-back in one transaction, so they
+         * share a single commit and sync to disk.
+         *
+         * If a write of a group throws, only that write fails. The group is rolled back and the
+         * other writes of the group are run again, as is the case when a write cancels the
+         * transaction. Writes that were already run before the group was rolled back are run again
+         * in their own transaction, so a write block is run at most twice. Write blocks must thus
+         * not have any side effects outside of the realm.
+         *
+         * @param maxWrites maximum number of writes in a single transaction. Must be positive.
+         * @param maxDuration no further writes are added to a transaction that has been running
+         * for longer than this. Must be positive.
+         * @throws IllegalArgumentException if [maxWrites] or [maxDuration] is not positive.
+         */
+        public fun groupCommit(maxWrites: Int, maxDuration: Duration): S = apply {
+            require(maxWrites > 0) { "Max writes must be positive: $maxWrites" }
+            require(maxDuration > Duration.ZERO) { "Max duration must be positive: $maxDuration" }
+            this.maxWriteGroupSize = maxWrites
+            this.maxWriteGroupDuration = maxDuration
+        } as S
+
         /**
          * Sets the schema version of the Realm. This must be equal to or higher than the schema
          * version of the existing Realm file, if any. If the schema version is higher than the
@@ -181,6 +181,9 @@ public interface RealmConfiguration : Configuration {
                 initialDataCallback,
                 inMemory,
                 initialRealmFileConfiguration,
+                coalesceNotifications,
+                maxWriteGroupSize,
+                maxWriteGroupDuration,
                 realmLogger
             )
         }
@@ -1,10 +1,16 @@
 package io.realm.kotlin.ext
 
 import io.realm.kotlin.TypedRealm
+import io.realm.kotlin.internal.RealmResultsImpl
 import io.realm.kotlin.internal.getRealm
+import io.realm.kotlin.internal.interop.PropertyType
+import io.realm.kotlin.internal.interop.RealmInterop
+import io.realm.kotlin.query.RealmColumn
 import io.realm.kotlin.query.RealmResults
 import io.realm.kotlin.types.RealmList
 import io.realm.kotlin.types.TypedRealmObject
+import kotlin.jvm.JvmName
+import kotlin.reflect.KProperty1
 
 /**
  * Makes an unmanaged in-memory copy of the elements in a [RealmResults]. This is a deep copy
@@ -20,3 +26,78 @@ public inline fun <reified T : TypedRealmObject> RealmResults<T>.copyFromRealm(d
     // the Realm is closed, so all error handling is done inside the `getRealm` method.
     return this.getRealm<TypedRealm>().copyFromRealm(this, depth)
 }
+
+/**
+ * Returns the values of a [Long] property of all objects in the results, read in a single pass
+ * without instantiating the objects.
+ *
+ * @param property the property to read, e.g. `Item::quantity`.
+ * @return the values of the property in the order of the results.
+ * @throws IllegalArgumentException if the property is not part of the schema.
+ * @throws IllegalStateException if the realm has been closed.
+ */
+@JvmName("longColumn")
+public fun <T : TypedRealmObject> RealmResults<T>.column(property: KProperty1<T, Long?>): RealmColumn<LongArray> =
+    (this as RealmResultsImpl<T>).column(property, PropertyType.RLM_PROPERTY_TYPE_INT, ::LongArray) { results, key, values, nulls ->
+        RealmInterop.realm_results_get_column(results, key, values, nulls)
+    }
+
+/**
+ * Returns the values of an [Int] property of all objects in the results, read in a single pass
+ * without instantiating the objects. Values are returned as [Long]s as that is how they are stored.
+ *
+ * @param property the property to read, e.g. `Item::count`.
+ * @return the values of the property in the order of the results.
+ * @throws IllegalArgumentException if the property is not part of the schema.
+ * @throws IllegalStateException if the realm has been closed.
+ */
+@JvmName("intColumn")
+public fun <T : TypedRealmObject> RealmResults<T>.column(property: KProperty1<T, Int?>): RealmColumn<LongArray> =
+    (this as RealmResultsImpl<T>).column(property, PropertyType.RLM_PROPERTY_TYPE_INT, ::LongArray) { results, key, values, nulls ->
+        RealmInterop.realm_results_get_column(results, key, values, nulls)
+    }
+
+/**
+ * Returns the values of a [Double] property of all objects in the results, read in a single pass
+ * without instantiating the objects.
+ *
+ * @param property the property to read, e.g. `Item::price`.
+ * @return the values of the property in the order of the results.
+ * @throws IllegalArgumentException if the property is not part of the schema.
+ * @throws IllegalStateException if the realm has been closed.
+ */
+@JvmName("doubleColumn")
+public fun <T : TypedRealmObject> RealmResults<T>.column(property: KProperty1<T, Double?>): RealmColumn<DoubleArray> =
+    (this as RealmResultsImpl<T>).column(property, PropertyType.RLM_PROPERTY_TYPE_DOUBLE, ::DoubleArray) { results, key, values, nulls ->
+        RealmInterop.realm_results_get_column(results, key, values, nulls)
+    }
+
+/**
+ * Returns the values of a [Float] property of all objects in the results, read in a single pass
+ * without instantiating the objects.
+ *
+ * @param property the property to read, e.g. `Item::weight`.
+ * @return the values of the property in the order of the results.
+ * @throws IllegalArgumentException if the property is not part of the schema.
+ * @throws IllegalStateException if the realm has been closed.
+ */
+@JvmName("floatColumn")
+public fun <T : TypedRealmObject> RealmResults<T>.column(property: KProperty1<T, Float?>): RealmColumn<FloatArray> =
+    (this as RealmResultsImpl<T>).column(property, PropertyType.RLM_PROPERTY_TYPE_FLOAT, ::FloatArray) { results, key, values, nulls ->
+        RealmInterop.realm_results_get_column(results, key, values, nulls)
+    }
+
+/**
+ * Returns the values of a [Boolean] property of all objects in the results, read in a single pass
+ * without instantiating the objects.
+ *
+ * @param property the property to read, e.g. `Item::inStock`.
+ * @return the values of the property in the order of the results.
+ * @throws IllegalArgumentException if the property is not part of the schema.
+ * @throws IllegalStateException if the realm has been closed.
+ */
+@JvmName("booleanColumn")
+public fun <T : TypedRealmObject> RealmResults<T>.column(property: KProperty1<T, Boolean?>): RealmColumn<BooleanArray> =
+    (this as RealmResultsImpl<T>).column(property, PropertyType.RLM_PROPERTY_TYPE_BOOL, ::BooleanArray) { results, key, values, nulls ->
+        RealmInterop.realm_results_get_column(results, key, values, nulls)
+    }
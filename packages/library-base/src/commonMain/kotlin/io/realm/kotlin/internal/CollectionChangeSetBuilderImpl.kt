@@ -35,8 +35,7 @@ internal abstract class CollectionChangeSetBuilderImpl<T>(
 ) : CollectionChangeSetBuilder<T, Range>() {
 
     init {
-        RealmInterop.realm_collection_changes_get_indices(change, this)
-        RealmInterop.realm_collection_changes_get_ranges(change, this)
+        RealmInterop.realm_collection_changes_get_change_set(change, this)
     }
 
     override fun initIndicesArray(size: Int, indicesAccessor: ArrayAccessor): IntArray =
@@ -45,6 +45,7 @@ import io.realm.kotlin.migration.AutomaticSchemaMigration
 import io.realm.kotlin.migration.RealmMigration
 import io.realm.kotlin.types.BaseRealmObject
 import kotlin.reflect.KClass
+import kotlin.time.Duration
 
 // TODO Public due to being accessed from `library-sync`
 @Suppress("LongParameterList")
@@ -65,6 +66,9 @@ public open class ConfigurationImpl(
     override val isFlexibleSyncConfiguration: Boolean,
     inMemory: Boolean,
     initialRealmFileConfiguration: InitialRealmFileConfiguration?,
+    override val coalesceNotifications: Boolean,
+    override val maxWriteGroupSize: Int,
+    override val maxWriteGroupDuration: Duration,
     override val logger: ContextLogger
 ) : InternalConfiguration {
 
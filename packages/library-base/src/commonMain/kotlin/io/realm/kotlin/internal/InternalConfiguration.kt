@@ -22,6 +22,7 @@ import io.realm.kotlin.internal.interop.SchemaMode
 import io.realm.kotlin.internal.util.CoroutineDispatcherFactory
 import io.realm.kotlin.types.BaseRealmObject
 import kotlin.reflect.KClass
+import kotlin.time.Duration
 
 /**
  * An **internal Realm configuration** that holds internal properties from a
@@ -37,6 +38,14 @@ public interface InternalConfiguration : Configuration {
     public val schemaMode: SchemaMode
     public val logger: ContextLogger
 
+    // Whether changes are merged while a flow collector is still processing a previous change
+    public val coalesceNotifications: Boolean
+
+    // Bounds of the writes committed together in a single transaction, a size of 1 disables
+    // grouping writes
+    public val maxWriteGroupSize: Int
+    public val maxWriteGroupDuration: Duration
+
     // Temporary work-around for https://github.com/realm/realm-kotlin/issues/724
     public val isFlexibleSyncConfiguration: Boolean
 
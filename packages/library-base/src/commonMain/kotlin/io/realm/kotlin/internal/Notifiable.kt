@@ -92,8 +92,9 @@ public abstract class ChangeFlow<T, C>(private val producerScope: ProducerScope<
      * longer present in the [SuspendableNotifier]'s live realm.
      * @param change the core change, or `null` if this is the initial event issued by the
      * [SuspendableNotifier] at the point of callback registration.
+     * @return whether an event was emitted.
      */
-    internal fun emit(frozenRef: T?, change: RealmChangesPointer? = null) {
+    internal fun emit(frozenRef: T?, change: RealmChangesPointer? = null): Boolean {
         val event = if (frozenRef != null) {
             if (initialElement) {
                 initialElement = false
@@ -109,6 +110,7 @@ public abstract class ChangeFlow<T, C>(private val producerScope: ProducerScope<
         if (frozenRef == null) {
             producerScope.close()
         }
+        return event != null
     }
 
     internal abstract fun initial(frozenRef: T): C
@@ -42,6 +42,18 @@ public class NotificationToken constructor(
         }
     }
 
+    /**
+     * Runs [block] unless the token has been cancelled. The token cannot be cancelled while
+     * [block] is running.
+     */
+    internal fun ifRegistered(block: () -> Unit) {
+        lock.withLock {
+            if (observer.value) {
+                block()
+            }
+        }
+    }
+
     // FIXME API We currently favor to do explicit registration.
     //  Only works on JVM. KN Cleaner is not available before v1.4.30-M1-eap-48
     //  https://github.com/realm/realm-kotlin/issues/23
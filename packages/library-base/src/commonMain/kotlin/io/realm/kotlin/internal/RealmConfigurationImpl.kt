@@ -25,6 +25,7 @@ import io.realm.kotlin.internal.util.CoroutineDispatcherFactory
 import io.realm.kotlin.migration.RealmMigration
 import io.realm.kotlin.types.BaseRealmObject
 import kotlin.reflect.KClass
+import kotlin.time.Duration
 
 public const val REALM_FILE_EXTENSION: String = ".realm"
 
@@ -45,6 +46,9 @@ internal class RealmConfigurationImpl(
     initialDataCallback: InitialDataCallback?,
     inMemory: Boolean,
     initialRealmFileConfiguration: InitialRealmFileConfiguration?,
+    coalesceNotifications: Boolean,
+    maxWriteGroupSize: Int,
+    maxWriteGroupDuration: Duration,
     logger: ContextLogger
 ) : ConfigurationImpl(
     directory,
@@ -66,6 +70,9 @@ internal class RealmConfigurationImpl(
     false,
     inMemory,
     initialRealmFileConfiguration,
+    coalesceNotifications,
+    maxWriteGroupSize,
+    maxWriteGroupDuration,
     logger
 ),
     RealmConfiguration
@@ -41,6 +41,8 @@ import io.realm.kotlin.internal.interop.RealmMapPointer
 import io.realm.kotlin.internal.interop.RealmObjectInterop
 import io.realm.kotlin.internal.interop.RealmSetPointer
 import io.realm.kotlin.internal.interop.RealmValue
+import io.realm.kotlin.internal.interop.RealmValueRow
+import io.realm.kotlin.internal.interop.RealmValueRowBuilder
 import io.realm.kotlin.internal.interop.Timestamp
 import io.realm.kotlin.internal.interop.getterScope
 import io.realm.kotlin.internal.interop.inputScope
@@ -264,49 +266,85 @@ internal object RealmObjectHelper {
     internal inline fun getLong(
         obj: RealmObjectReference<out BaseRealmObject>,
         propertyName: String
-    ): Long? = getterScope { getRealmValue(obj, propertyName)?.let { realmValueToLong(it) } }
+    ): Long? = getPrefetchedOrElse(obj, propertyName, { getLong(it) }) { realmValueToLong(it) }
 
     internal inline fun getBoolean(
         obj: RealmObjectReference<out BaseRealmObject>,
         propertyName: String
-    ): Boolean? = getterScope { getRealmValue(obj, propertyName)?.let { realmValueToBoolean(it) } }
+    ): Boolean? = getPrefetchedOrElse(obj, propertyName, { getBoolean(it) }) { realmValueToBoolean(it) }
 
     internal inline fun getFloat(
         obj: RealmObjectReference<out BaseRealmObject>,
         propertyName: String
-    ): Float? = getterScope { getRealmValue(obj, propertyName)?.let { realmValueToFloat(it) } }
+    ): Float? = getPrefetchedOrElse(obj, propertyName, { getFloat(it) }) { realmValueToFloat(it) }
 
     internal inline fun getDouble(
         obj: RealmObjectReference<out BaseRealmObject>,
         propertyName: String
-    ): Double? = getterScope { getRealmValue(obj, propertyName)?.let { realmValueToDouble(it) } }
+    ): Double? = getPrefetchedOrElse(obj, propertyName, { getDouble(it) }) { realmValueToDouble(it) }
 
+    @OptIn(ExperimentalUnsignedTypes::class)
     internal inline fun getDecimal128(
         obj: RealmObjectReference<out BaseRealmObject>,
         propertyName: String
-    ): Decimal128? = getterScope { getRealmValue(obj, propertyName)?.let { realmValueToDecimal128(it) } }
+    ): Decimal128? = getPrefetchedOrElse(
+        obj,
+        propertyName,
+        { getDecimal128Array(it).let { w -> Decimal128.fromIEEE754BIDEncoding(w[1], w[0]) } }
+    ) { realmValueToDecimal128(it) }
 
     internal inline fun getInstant(
         obj: RealmObjectReference<out BaseRealmObject>,
         propertyName: String
-    ): RealmInstant? =
-        getterScope { getRealmValue(obj, propertyName)?.let { realmValueToRealmInstant(it) } }
+    ): RealmInstant? = getPrefetchedOrElse(
+        obj,
+        propertyName,
+        { RealmInstantImpl(getTimestamp(it)) }
+    ) { realmValueToRealmInstant(it) }
 
     internal inline fun getObjectId(
         obj: RealmObjectReference<out BaseRealmObject>,
         propertyName: String
-    ): BsonObjectId? = getterScope { getRealmValue(obj, propertyName)?.let { realmValueToObjectId(it) } }
+    ): BsonObjectId? = getPrefetchedOrElse(
+        obj,
+        propertyName,
+        { BsonObjectId(getObjectIdBytes(it)) }
+    ) { realmValueToObjectId(it) }
 
     internal inline fun getUUID(
         obj: RealmObjectReference<out BaseRealmObject>,
         propertyName: String
-    ): RealmUUID? = getterScope { getRealmValue(obj, propertyName)?.let { realmValueToRealmUUID(it) } }
+    ): RealmUUID? = getPrefetchedOrElse(
+        obj,
+        propertyName,
+        { RealmUUIDImpl(getUUIDBytes(it)) }
+    ) { realmValueToRealmUUID(it) }
 
     internal inline fun getByteArray(
         obj: RealmObjectReference<out BaseRealmObject>,
         propertyName: String
     ): ByteArray? = getterScope { getRealmValue(obj, propertyName)?.let { realmValueToByteArray(it) } }
 
+    /**
+     * Returns the value of a property from the prefetched row of a frozen object through
+     * [fromRow], or reads the single property from the C-API and converts it with
+     * [fromRealmValue] if the value is not part of a prefetched row.
+     */
+    @Suppress("ReturnCount")
+    internal inline fun <T> getPrefetchedOrElse(
+        obj: RealmObjectReference<out BaseRealmObject>,
+        propertyName: String,
+        fromRow: RealmValueRow.(Int) -> T,
+        fromRealmValue: (RealmValue) -> T
+    ): T? {
+        val property = obj.propertyInfoOrThrow(propertyName)
+        obj.prefetchedRow(property)?.let { row ->
+            val index = property.rowIndex
+            return if (row.isNull(index)) null else row.fromRow(index)
+        }
+        return getterScope { getRealmValueFromKey(obj, property.key)?.let(fromRealmValue) }
+    }
+
     internal inline fun getRealmAny(
         obj: RealmObjectReference<out BaseRealmObject>,
         propertyName: String
@@ -757,7 +795,11 @@ internal object RealmObjectHelper {
         cache: UnmanagedToManagedObjectCache
     ) {
         val metadata: ClassMetadata = target.realmObjectReference!!.metadata
-        // TODO OPTIMIZE We could set all properties at once with one C-API call
+        // Primitive values are collected and set with a single C-API call after assigning the
+        // remaining properties. A batch only holds the properties of this object. Linked and
+        // embedded objects are created and assigned while recursing through the graph, so each of
+        // them sets its own batch, even when they are of the same class.
+        val primitiveValues = RealmValueRowBuilder(metadata.properties.size)
         metadata.properties.filter {
             // Primary keys are set at construction time
             // Computed properties have no assignment
@@ -811,7 +853,9 @@ internal object RealmObjectHelper {
                     }
                     else -> {
                         val getterValue = accessor.get(source)
-                        accessor.set(target, getterValue)
+                        if (!primitiveValues.addPrimitive(property.key, getterValue)) {
+                            accessor.set(target, getterValue)
+                        }
                     }
                 }
                 CollectionType.RLM_COLLECTION_TYPE_LIST -> {
@@ -850,6 +894,42 @@ internal object RealmObjectHelper {
                 else -> TODO("Collection type ${property.collectionType} is not supported")
             }
         }
+        if (primitiveValues.size > 0) {
+            RealmInterop.realm_set_values(
+                target.realmObjectReference!!.objectPointer,
+                primitiveValues,
+                false
+            )
+        }
+    }
+
+    /**
+     * Adds values of the public types of primitive properties to the builder, converting them the
+     * same way as the generated accessors. Returns `false` if the value is not of a primitive type,
+     * in which case it should be assigned through the accessor instead.
+     */
+    @Suppress("ComplexMethod", "ReturnCount")
+    private fun RealmValueRowBuilder.addPrimitive(key: PropertyKey, value: Any?): Boolean {
+        when (value) {
+            null -> addNull(key)
+            is String -> addString(key, value)
+            is ByteArray -> addByteArray(key, value)
+            is Long -> addLong(key, value)
+            is Int -> addLong(key, value.toLong())
+            is Short -> addLong(key, value.toLong())
+            is Byte -> addLong(key, value.toLong())
+            is Char -> addLong(key, value.code.toLong())
+            is Boolean -> addBoolean(key, value)
+            is Timestamp -> addTimestamp(key, value)
+            is Float -> addFloat(key, value)
+            is Double -> addDouble(key, value)
+            is Decimal128 -> addDecimal128(key, value)
+            is BsonObjectId -> addObjectId(key, value.toByteArray())
+            is RealmUUID -> addUUID(key, value.bytes)
+            is MutableRealmInt -> addLong(key, value.get())
+            else -> return false
+        }
+        return true
     }
 
     @Suppress("LongParameterList")
@@ -24,13 +24,17 @@ import io.realm.kotlin.internal.interop.RealmKeyPathArrayPointer
 import io.realm.kotlin.internal.interop.RealmNotificationTokenPointer
 import io.realm.kotlin.internal.interop.RealmObjectInterop
 import io.realm.kotlin.internal.interop.RealmObjectPointer
+import io.realm.kotlin.internal.interop.RealmValueRow
 import io.realm.kotlin.internal.schema.ClassMetadata
+import io.realm.kotlin.internal.schema.NO_ROW_INDEX
 import io.realm.kotlin.internal.schema.PropertyMetadata
 import io.realm.kotlin.notifications.ObjectChange
 import io.realm.kotlin.notifications.internal.DeletedObjectImpl
 import io.realm.kotlin.notifications.internal.InitialObjectImpl
 import io.realm.kotlin.notifications.internal.UpdatedObjectImpl
 import io.realm.kotlin.types.BaseRealmObject
+import kotlinx.atomicfu.AtomicRef
+import kotlinx.atomicfu.atomic
 import kotlinx.coroutines.channels.ProducerScope
 import kotlinx.coroutines.flow.Flow
 import kotlin.reflect.KClass
@@ -56,12 +60,31 @@ public class RealmObjectReference<T : BaseRealmObject>(
 
     public val metadata: ClassMetadata = owner.schemaMetadata[className]!!
 
+    // Values of all row properties (see ClassMetadata.rowPropertyKeys) of an object from a frozen
+    // realm. The values of a frozen object never change, so they are all read with a single call on
+    // first access instead of calling into the C-API for every single property. Frozen objects can
+    // be shared across threads, so the row is only published once it has been read completely.
+    private val row: AtomicRef<RealmValueRow?> = atomic(null)
+
     // Any methods added to this interface, needs to be fake overridden on the user classes by
     // the compiler plugin, see "RealmObjectInternal overrides" in RealmModelLowering.lower
     public fun propertyInfoOrThrow(
         propertyName: String
     ): PropertyMetadata = this.metadata.getOrThrow(propertyName)
 
+    /**
+     * Returns the prefetched values of a frozen object if [property] is part of the bulk read row,
+     * otherwise `null`.
+     */
+    internal fun prefetchedRow(property: PropertyMetadata): RealmValueRow? {
+        if (owner !is FrozenRealmReference || property.rowIndex == NO_ROW_INDEX) {
+            return null
+        }
+        owner.checkClosed()
+        return row.value ?: RealmInterop.realm_get_values(objectPointer, metadata.rowPropertyKeys)
+            .also { row.value = it }
+    }
+
     override fun realmState(): RealmState {
         return owner
     }
@@ -19,12 +19,16 @@ package io.realm.kotlin.internal
 import io.realm.kotlin.internal.RealmValueArgumentConverter.convertToQueryArgs
 import io.realm.kotlin.internal.interop.Callback
 import io.realm.kotlin.internal.interop.ClassKey
+import io.realm.kotlin.internal.interop.CollectionType
+import io.realm.kotlin.internal.interop.PropertyKey
+import io.realm.kotlin.internal.interop.PropertyType
 import io.realm.kotlin.internal.interop.RealmChangesPointer
 import io.realm.kotlin.internal.interop.RealmInterop
 import io.realm.kotlin.internal.interop.RealmInterop.realm_results_get
 import io.realm.kotlin.internal.interop.RealmKeyPathArrayPointer
 import io.realm.kotlin.internal.interop.RealmNotificationTokenPointer
 import io.realm.kotlin.internal.interop.RealmResultsPointer
+import io.realm.kotlin.internal.interop.RealmValueRow
 import io.realm.kotlin.internal.interop.getterScope
 import io.realm.kotlin.internal.interop.inputScope
 import io.realm.kotlin.internal.query.ObjectQuery
@@ -32,13 +36,16 @@ import io.realm.kotlin.internal.util.Validation.sdkError
 import io.realm.kotlin.notifications.ResultsChange
 import io.realm.kotlin.notifications.internal.InitialResultsImpl
 import io.realm.kotlin.notifications.internal.UpdatedResultsImpl
+import io.realm.kotlin.query.RealmColumn
 import io.realm.kotlin.query.RealmQuery
 import io.realm.kotlin.query.RealmResults
 import io.realm.kotlin.query.TRUE_PREDICATE
 import io.realm.kotlin.types.BaseRealmObject
 import kotlinx.coroutines.channels.ProducerScope
 import kotlinx.coroutines.flow.Flow
+import kotlin.math.min
 import kotlin.reflect.KClass
+import kotlin.reflect.KProperty1
 
 /**
  * Primitive results are not exposed through the public API but might be needed when implementing
@@ -75,6 +82,34 @@ internal class RealmResultsImpl<E : BaseRealmObject> constructor(
         ) as E
     }
 
+    /**
+     * Reads the values of a single primitive property of all objects in the results through [read]
+     * into an array created by [create].
+     */
+    internal fun <A : Any> column(
+        property: KProperty1<E, *>,
+        type: PropertyType,
+        create: (Int) -> A,
+        read: (RealmResultsPointer, PropertyKey, A, ByteArray) -> Unit
+    ): RealmColumn<A> {
+        realm.checkClosed()
+        val propertyMetadata = realm.schemaMetadata[classKey]?.get(property.name)
+            ?: throw IllegalArgumentException("Schema doesn't contain a property named '${property.name}'")
+        if (propertyMetadata.collectionType != CollectionType.RLM_COLLECTION_TYPE_NONE || propertyMetadata.type != type) {
+            throw IllegalArgumentException("Property '${property.name}' cannot be read as a column of type $type")
+        }
+        val size = this.size
+        val values = create(size)
+        val nulls = ByteArray((size + 7) / 8)
+        read(nativePointer, propertyMetadata.key, values, nulls)
+        return RealmColumn(size, values, nulls)
+    }
+
+    override fun iterator(): Iterator<E> = when (realm) {
+        is FrozenRealmReference -> PagedIterator()
+        else -> super.iterator()
+    }
+
     override fun query(query: String, vararg args: Any?): RealmQuery<E> = inputScope {
         // If an empty query is passed in, reconstruct the original query backing this RealmResults
         val queryPointer = if (query.trim().compareTo(TRUE_PREDICATE, ignoreCase = true) == 0 && args.isEmpty()) {
@@ -147,6 +182,42 @@ internal class RealmResultsImpl<E : BaseRealmObject> constructor(
     override fun isValid(): Boolean {
         return !nativePointer.isReleased() && !realm.isClosed()
     }
+
+    /**
+     * Iterator over frozen results that reads the elements of a whole page with a single call into
+     * the C-API instead of one call per element. Frozen results never change, so pages can be
+     * fetched ahead of the elements being consumed.
+     */
+    private inner class PagedIterator : Iterator<E> {
+        private val size: Int = this@RealmResultsImpl.size
+        private var index: Int = 0
+        private var pageStart: Int = 0
+        private var page: RealmValueRow? = null
+
+        override fun hasNext(): Boolean = index < size
+
+        override fun next(): E {
+            if (index >= size) {
+                throw NoSuchElementException()
+            }
+            val current = page?.takeIf { index - pageStart < it.size }
+                ?: RealmInterop.realm_results_get_range(
+                    nativePointer,
+                    index.toLong(),
+                    min(PAGE_SIZE, size - index)
+                ).also {
+                    page = it
+                    pageStart = index
+                }
+            val element = current.getLink(index - pageStart).toRealmObject(clazz, mediator, realm)
+            index++
+            return element
+        }
+    }
+
+    private companion object {
+        const val PAGE_SIZE = 256
+    }
 }
 
 internal class ResultChangeFlow<E : BaseRealmObject>(scope: ProducerScope<ResultsChange<E>>) :
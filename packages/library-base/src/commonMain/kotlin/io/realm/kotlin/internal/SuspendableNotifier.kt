@@ -2,6 +2,7 @@ package io.realm.kotlin.internal
 
 import io.realm.kotlin.VersionId
 import io.realm.kotlin.internal.interop.Callback
+import io.realm.kotlin.internal.interop.CoalescingCallback
 import io.realm.kotlin.internal.interop.RealmChangesPointer
 import io.realm.kotlin.internal.interop.RealmInterop
 import io.realm.kotlin.internal.interop.RealmKeyPathArrayPointer
@@ -21,6 +22,7 @@ import kotlinx.coroutines.flow.Flow
 import kotlinx.coroutines.flow.MutableSharedFlow
 import kotlinx.coroutines.flow.asSharedFlow
 import kotlinx.coroutines.flow.callbackFlow
+import kotlinx.coroutines.flow.flow
 import kotlinx.coroutines.withContext
 
 /**
@@ -98,6 +100,36 @@ internal class SuspendableNotifier(
     }
 
     internal fun <T : CoreNotifiable<T, C>, C> registerObserver(flowable: Observable<T, C>, keyPathsPtr: RealmKeyPathArrayPointer?): Flow<C> {
+        if (!owner.configuration.coalesceNotifications) {
+            return observe(flowable, keyPathsPtr, null)
+        }
+        // Changes are merged while the collector processes an element, so only signal readiness
+        // once the element has been handled downstream.
+        return flow {
+            val readySignal = ReadySignal()
+            observe(flowable, keyPathsPtr, readySignal).collect {
+                emit(it)
+                withContext(dispatcher) { readySignal.signal() }
+            }
+        }
+    }
+
+    // Signals a coalescing registration that its collector is ready for the next change. Must
+    // only be accessed from the dispatchers thread.
+    private class ReadySignal {
+        var token: NotificationToken? = null
+        var ready: (() -> Unit)? = null
+
+        fun signal() {
+            token?.ifRegistered { ready?.invoke() }
+        }
+    }
+
+    private fun <T : CoreNotifiable<T, C>, C> observe(
+        flowable: Observable<T, C>,
+        keyPathsPtr: RealmKeyPathArrayPointer?,
+        readySignal: ReadySignal?
+    ): Flow<C> {
         return callbackFlow {
             val token: AtomicRef<Cancellable> =
                 kotlinx.atomicfu.atomic(NO_OP_NOTIFICATION_TOKEN)
@@ -117,25 +149,45 @@ internal class SuspendableNotifier(
                 // but can still be a deletion-event if the observed element is deleted at that
                 // moment in time.
                 if (lifeRef != null) {
-                    val interopCallback: Callback<RealmChangesPointer> =
+                    val deliver: (RealmChangesPointer) -> Unit = { change ->
+                        var emitted = false
+                        try {
+                            // Notifications need to be delivered with the version they where created on, otherwise
+                            // the fine-grained notification data might be out of sync.
+                            // TODO Currently verifying that lifeRef is still valid to indicate
+                            //  if it was actually deleted. This is only a problem for
+                            //  collections as they seemed to be freezable from a deleted
+                            //  reference (contrary to other objects that returns null from
+                            //  freeze). An `out_collection_was_deleted` flag was added to the
+                            //  change object, which would probably be the way to go, but
+                            //  requires rework of our change set build infrastructure.
+                            val frozenObservable: T? = if (lifeRef.isValid())
+                                lifeRef.freeze(realm.gcTrackedSnapshot())
+                            else null
+                            emitted = changeFlow.emit(frozenObservable, change)
+                        } finally {
+                            // The collector never sees changes that are not emitted, also if
+                            // emitting failed, so it cannot signal readiness for them
+                            if (!emitted) {
+                                readySignal?.signal()
+                            }
+                        }
+                    }
+                    val interopCallback: Callback<RealmChangesPointer> = if (readySignal == null) {
                         object : Callback<RealmChangesPointer> {
-                            override fun onChange(change: RealmChangesPointer) {
-                                // Notifications need to be delivered with the version they where created on, otherwise
-                                // the fine-grained notification data might be out of sync.
-                                // TODO Currently verifying that lifeRef is still valid to indicate
-                                //  if it was actually deleted. This is only a problem for
-                                //  collections as they seemed to be freezable from a deleted
-                                //  reference (contrary to other objects that returns null from
-                                //  freeze). An `out_collection_was_deleted` flag was added to the
-                                //  change object, which would probably be the way to go, but
-                                //  requires rework of our change set build infrastructure.
-                                val frozenObservable: T? = if (lifeRef.isValid())
-                                    lifeRef.freeze(realm.gcTrackedSnapshot())
-                                else null
-                                changeFlow.emit(frozenObservable, change)
+                            override fun onChange(change: RealmChangesPointer) = deliver(change)
+                        }
+                    } else {
+                        object : CoalescingCallback<RealmChangesPointer> {
+                            override fun onChange(change: RealmChangesPointer) = deliver(change)
+                            override fun onRegistered(ready: () -> Unit) {
+                                readySignal.ready = ready
                             }
                         }
-                    token.value = NotificationToken(lifeRef.registerForNotification(keyPathsPtr, interopCallback))
+                    }
+                    val notificationToken = NotificationToken(lifeRef.registerForNotification(keyPathsPtr, interopCallback))
+                    readySignal?.token = notificationToken
+                    token.value = notificationToken
                 } else {
                     changeFlow.emit(null)
                 }
@@ -20,6 +20,7 @@ import io.realm.kotlin.MutableRealm
 import io.realm.kotlin.ext.isManaged
 import io.realm.kotlin.ext.isValid
 import io.realm.kotlin.internal.interop.RealmInterop
+import io.realm.kotlin.internal.interop.SynchronizableObject
 import io.realm.kotlin.internal.platform.runBlocking
 import io.realm.kotlin.internal.platform.threadId
 import io.realm.kotlin.internal.schema.RealmClassImpl
@@ -28,12 +29,17 @@ import io.realm.kotlin.internal.util.LiveRealmContext
 import io.realm.kotlin.query.RealmQuery
 import io.realm.kotlin.types.BaseRealmObject
 import io.realm.kotlin.types.TypedRealmObject
+import kotlinx.coroutines.CancellationException
+import kotlinx.coroutines.CompletableDeferred
 import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.Job
+import kotlinx.coroutines.currentCoroutineContext
 import kotlinx.coroutines.ensureActive
 import kotlinx.coroutines.sync.Mutex
 import kotlinx.coroutines.sync.withLock
 import kotlinx.coroutines.withContext
 import kotlin.reflect.KClass
+import kotlin.time.TimeSource
 
 /**
  * A _suspendable writer_ to handle all asynchronous updates to a Realm through a suspendable API.
@@ -89,6 +95,24 @@ internal class SuspendableWriter(
     private val shouldClose = kotlinx.atomicfu.atomic<Boolean>(false)
     private val transactionMutex = Mutex(false)
 
+    private val maxWriteGroupSize = owner.configuration.maxWriteGroupSize
+    private val maxWriteGroupDuration = owner.configuration.maxWriteGroupDuration
+    // Writes waiting to be committed as part of a group
+    private val pendingWritesLock = SynchronizableObject()
+    private val pendingWrites = ArrayDeque<PendingWrite<*>>()
+
+    private class PendingWrite<R>(val block: MutableRealm.() -> R, val job: Job?) {
+        val result = CompletableDeferred<R>()
+        // Whether the write must run in its own transaction, as it cancels the transaction or has
+        // already been rolled back with a group
+        var alone = false
+
+        @Suppress("UNCHECKED_CAST")
+        fun complete(value: Any?) {
+            result.complete(value as R)
+        }
+    }
+
     init {
         tid = runBlocking(dispatcher) { threadId() }
     }
@@ -114,41 +138,190 @@ internal class SuspendableWriter(
     }
 
     suspend fun <R> write(block: MutableRealm.() -> R): R {
+        if (maxWriteGroupSize > 1) {
+            return groupWrite(block)
+        }
         // TODO Would we be able to offer a per write error handler by adding a CoroutineExceptionHandler
         return withContext(dispatcher) {
-            var result: R
+            transactionMutex.withLock {
+                transaction(block) { ensureActive() }
+            }
+        }
+    }
 
+    // Runs the block in its own transaction. Must be called on the dispatcher holding the
+    // transaction mutex.
+    private inline fun <R> transaction(block: MutableRealm.() -> R, ensureActive: () -> Unit): R {
+        val result: R
+        try {
+            realm.beginTransaction()
+            ensureActive()
+            result = block(realm)
+            ensureActive()
+            if (!shouldClose.value && realm.isInTransaction()) {
+                realm.commitTransaction()
+            } else {
+                if (shouldClose.value)
+                    throw IllegalStateException("Cannot commit transaction on closed realm")
+            }
+        } catch (e: Throwable) {
+            if (realm.isInTransaction()) {
+                realm.cancelWrite()
+            }
+            throw e
+        }
+        realm.updateSnapshot()
+        return frozenWriteReturnValue(result)
+    }
+
+    // Group commit: Writes are queued and whichever writer gets hold of the transaction runs the
+    // queued writes back-to-back in a single transaction, so they share a single commit and sync
+    // to disk. Writes queue up while a group is being committed, so groups grow with the load.
+    private suspend fun <R> groupWrite(block: MutableRealm.() -> R): R {
+        val write = PendingWrite(block, currentCoroutineContext()[Job])
+        pendingWritesLock.withLock { pendingWrites.addLast(write) }
+        withContext(dispatcher) {
             transactionMutex.withLock {
-                try {
-                    realm.beginTransaction()
-                    ensureActive()
-                    result = block(realm)
-                    ensureActive()
-                    if (!shouldClose.value && realm.isInTransaction()) {
-                        realm.commitTransaction()
-                    } else {
-                        if (shouldClose.value)
-                            throw IllegalStateException("Cannot commit transaction on closed realm")
-                    }
-                } catch (e: Throwable) {
-                    if (realm.isInTransaction()) {
-                        realm.cancelWrite()
-                    }
-                    throw e
+                // The write might already have been committed as part of an earlier group
+                while (!write.result.isCompleted) {
+                    commitGroup(nextGroup())
                 }
             }
+        }
+        return write.result.await()
+    }
+
+    private fun nextGroup(): List<PendingWrite<*>> = pendingWritesLock.withLock {
+        val group = ArrayList<PendingWrite<*>>(minOf(pendingWrites.size, maxWriteGroupSize))
+        while (group.size < maxWriteGroupSize && pendingWrites.isNotEmpty()) {
+            val next = pendingWrites.first()
+            if (next.alone && group.isNotEmpty()) {
+                break
+            }
+            group.add(pendingWrites.removeFirst())
+            if (next.alone) {
+                break
+            }
+        }
+        group
+    }
+
+    // Puts writes back in front of the queue, so they are picked up by the next group in order
+    private fun requeue(writes: List<PendingWrite<*>>) {
+        pendingWritesLock.withLock {
+            writes.asReversed().forEach { pendingWrites.addFirst(it) }
+        }
+    }
+
+    private fun commitGroup(group: List<PendingWrite<*>>) {
+        val writes = group.filter { write ->
+            (write.job?.isCancelled != true).also { active ->
+                if (!active) write.result.cancel()
+            }
+        }
+        if (writes.size <= 1) {
+            writes.forEach { runAlone(it) }
+            return
+        }
+        val results = ArrayList<Any?>(writes.size)
+        try {
+            realm.beginTransaction()
+        } catch (e: Throwable) {
+            writes.forEach { it.result.completeExceptionally(e) }
+            return
+        }
+        val start = TimeSource.Monotonic.markNow()
+        for (write in writes) {
+            val result = try {
+                write.block(realm)
+            } catch (e: Throwable) {
+                // Writes are applied in order, so the write fails the same way as on its own after
+                // the writes before it. Nothing has been committed, so the other writes of the
+                // group are run again without it.
+                cancelGroup()
+                if (e is CancellationException) {
+                    write.result.cancel(e)
+                } else {
+                    write.result.completeExceptionally(e)
+                }
+                requeue(rolledBack(writes.subList(0, results.size)) + writes.subList(results.size + 1, writes.size))
+                return
+            }
+            if (!realm.isInTransaction()) {
+                // Cancelling the transaction discarded the writes before it as well, so those are
+                // run again and the cancelling write on its own after them
+                requeue(rolledBack(writes.subList(0, results.size + 1)) + writes.subList(results.size + 1, writes.size))
+                return
+            }
+            results.add(result)
+            if (start.elapsedNow() >= maxWriteGroupDuration) {
+                break
+            }
+        }
+        val applied = writes.subList(0, results.size)
+        // Writes left out due to the duration bound are run in the next group
+        val remaining = writes.subList(results.size, writes.size)
+        // Writes whose caller has been cancelled in the meantime must not be committed
+        val cancelled = applied.filter { it.job?.isCancelled == true }
+        if (cancelled.isNotEmpty()) {
+            cancelGroup()
+            cancelled.forEach { it.result.cancel() }
+            requeue(rolledBack(applied - cancelled.toSet()) + remaining)
+            return
+        }
+        try {
+            if (shouldClose.value) {
+                throw IllegalStateException("Cannot commit transaction on closed realm")
+            }
+            realm.commitTransaction()
+        } catch (e: Throwable) {
+            // The outcome of the commit is shared by all writes of the group
+            cancelGroup()
+            applied.forEach { it.result.completeExceptionally(e) }
+            requeue(remaining)
+            return
+        }
+        requeue(remaining)
+        try {
             realm.updateSnapshot()
-            if (shouldFreezeWriteReturnValue(result)) {
-                // Freeze the result in the context of the Dispatcher. The dispatcher should be
-                // single-threaded so will guarantee that no other threads can modify the Realm
-                // between the transaction is committed and we freeze it.
-                // TODO Can we guarantee the Dispatcher is single-threaded? Or otherwise
-                //  lock this code?
-                val newReference = realm.gcTrackedSnapshot()
-                freezeWriteReturnValue(newReference, result)
-            } else {
-                result
+            results.forEachIndexed { index, result ->
+                applied[index].complete(frozenWriteReturnValue(result))
             }
+        } catch (e: Throwable) {
+            applied.forEach { it.result.completeExceptionally(e) }
+        }
+    }
+
+    // Writes that were rolled back with their group are run again in their own transaction, so a
+    // write is run at most twice no matter how many writes of the following groups fail
+    private fun rolledBack(writes: List<PendingWrite<*>>): List<PendingWrite<*>> =
+        writes.onEach { it.alone = true }
+
+    private fun cancelGroup() {
+        if (realm.isInTransaction()) {
+            realm.cancelWrite()
+        }
+    }
+
+    private fun runAlone(write: PendingWrite<*>) {
+        try {
+            write.complete(transaction(write.block) { write.job?.ensureActive() })
+        } catch (e: Throwable) {
+            write.result.completeExceptionally(e)
+        }
+    }
+
+    private fun <R> frozenWriteReturnValue(result: R): R {
+        return if (shouldFreezeWriteReturnValue(result)) {
+            // Freeze the result in the context of the Dispatcher. The dispatcher should be
+            // single-threaded so will guarantee that no other threads can modify the Realm
+            // between the transaction is committed and we freeze it.
+            // TODO Can we guarantee the Dispatcher is single-threaded? Or otherwise
+            //  lock this code?
+            val newReference = realm.gcTrackedSnapshot()
+            freezeWriteReturnValue(newReference, result)
+        } else {
+            result
         }
     }
 
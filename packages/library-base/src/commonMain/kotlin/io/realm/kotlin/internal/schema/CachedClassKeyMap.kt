@@ -56,6 +56,12 @@ public interface ClassMetadata {
     public operator fun get(property: KProperty<*>): PropertyMetadata?
     public fun getOrThrow(propertyName: String): PropertyMetadata = this[propertyName]
         ?: throw IllegalArgumentException("Schema for type '$className' doesn't contain a property named '$propertyName'")
+    /**
+     * Keys of the properties that are read in bulk when accessing objects of frozen realms. The
+     * position of a property in this array is given by [PropertyMetadata.rowIndex].
+     */
+    public val rowPropertyKeys: LongArray
+        get() = EMPTY_ROW
     /**
      * Returns `true` if this class has been defined by the user, `false` is returned
      * if this class is only found in the on-disk schema.
@@ -75,6 +81,12 @@ public interface PropertyMetadata {
     public val linkTarget: String
     public val linkOriginPropertyName: String
     public val isComputed: Boolean
+    /**
+     * Index of this property in [ClassMetadata.rowPropertyKeys] or [NO_ROW_INDEX] if the property
+     * is not read in bulk.
+     */
+    public val rowIndex: Int
+        get() = NO_ROW_INDEX
     /**
      * Returns `true` if this property has been defined by the user, `false` is returned
      * if this property is only found in the on-disk schema.
@@ -82,6 +94,9 @@ public interface PropertyMetadata {
     public fun isUserDefined(): Boolean = (accessor != null)
 }
 
+public const val NO_ROW_INDEX: Int = -1
+private val EMPTY_ROW = LongArray(0)
+
 /**
  * Schema metadata implementation that postpones class key lookup until first access.
  *
@@ -136,6 +151,7 @@ public class CachedClassMetadata(
     override val primaryKeyProperty: PropertyMetadata?
     override val isEmbeddedRealmObject: Boolean
     override val clazz: KClass<out TypedRealmObject>? = companion?.io_realm_kotlin_class
+    override val rowPropertyKeys: LongArray
 
     init {
         val classInfo = RealmInterop.realm_get_class(dbPointer, classKey)
@@ -144,13 +160,18 @@ public class CachedClassMetadata(
             classInfo.key,
             classInfo.numProperties + classInfo.numComputedProperties
         ).let { interopProperties ->
+            var rowSize = 0
             properties = interopProperties.map { propertyInfo: PropertyInfo ->
                 CachedPropertyMetadata(
                     propertyInfo,
-                    companion?.io_realm_kotlin_fields?.get(propertyInfo.name)?.second
+                    companion?.io_realm_kotlin_fields?.get(propertyInfo.name)?.second,
+                    if (propertyInfo.isRowProperty()) rowSize++ else NO_ROW_INDEX
                 )
             }
         }
+        rowPropertyKeys = properties.filter { it.rowIndex != NO_ROW_INDEX }
+            .map { it.key.key }
+            .toLongArray()
 
         // TODO OPTIMIZE We should initialize this in one iteration
         primaryKeyProperty = properties.firstOrNull { it.isPrimaryKey }
@@ -168,7 +189,8 @@ public class CachedClassMetadata(
 
 public class CachedPropertyMetadata(
     propertyInfo: PropertyInfo,
-    override val accessor: KProperty1<BaseRealmObject, Any?>? = null
+    override val accessor: KProperty1<BaseRealmObject, Any?>? = null,
+    override val rowIndex: Int = NO_ROW_INDEX,
 ) : PropertyMetadata {
     override val name: String = propertyInfo.name
     override val publicName: String = propertyInfo.publicName
@@ -181,3 +203,19 @@ public class CachedPropertyMetadata(
     override val linkOriginPropertyName: String = propertyInfo.linkOriginPropertyName
     override val isComputed: Boolean = propertyInfo.isComputed
 }
+
+// Only properties with small fixed size values are read in bulk. Strings and binaries are excluded
+// as they can be arbitrarily large and would be decoded and retained on the first access of any
+// property, so they are only read when actually accessed.
+private fun PropertyInfo.isRowProperty(): Boolean =
+    !isComputed && collectionType == CollectionType.RLM_COLLECTION_TYPE_NONE && when (type) {
+        PropertyType.RLM_PROPERTY_TYPE_INT,
+        PropertyType.RLM_PROPERTY_TYPE_BOOL,
+        PropertyType.RLM_PROPERTY_TYPE_TIMESTAMP,
+        PropertyType.RLM_PROPERTY_TYPE_FLOAT,
+        PropertyType.RLM_PROPERTY_TYPE_DOUBLE,
+        PropertyType.RLM_PROPERTY_TYPE_OBJECT_ID,
+        PropertyType.RLM_PROPERTY_TYPE_DECIMAL128,
+        PropertyType.RLM_PROPERTY_TYPE_UUID -> true
+        else -> false
+    }
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.kotlin.query
+
+import io.realm.kotlin.ext.column
+
+/**
+ * The values of a single property across all elements of a [RealmResults] as returned by
+ * [RealmResults.column].
+ *
+ * The values are held in a primitive array, [values], with one entry per element in the order of
+ * the results. As primitive arrays cannot hold `null`, null values are tracked separately and
+ * should be checked with [isNull] for nullable properties.
+ *
+ * @param A the type of primitive array holding the values.
+ */
+public class RealmColumn<out A : Any> internal constructor(
+    /**
+     * Number of values in the column.
+     */
+    public val size: Int,
+    /**
+     * The values of the column. Entries of `null` values hold the default value of the type.
+     */
+    public val values: A,
+    private val nulls: ByteArray,
+) {
+    /**
+     * Returns `true` if the value at [index] is `null`, `false` otherwise.
+     */
+    public fun isNull(index: Int): Boolean {
+        if (index < 0 || index >= size) {
+            throw IndexOutOfBoundsException("Index $index is out of bounds for column of size $size")
+        }
+        return nulls[index / 8].toInt() and (1 shl (index % 8)) != 0
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package io.realm.kotlin.ext
+
+import io.realm.kotlin.internal.FrozenRealmReference
+import io.realm.kotlin.internal.interop.CollectionType
+import io.realm.kotlin.internal.interop.PropertyType
+import io.realm.kotlin.internal.interop.RealmInterop
+import io.realm.kotlin.internal.realmObjectReference
+import io.realm.kotlin.types.TypedRealmObject
+import java.nio.ByteBuffer
+import kotlin.reflect.KProperty1
+
+/**
+ * Calls [block] with a read-only view of the UTF-8 encoded bytes of a [String] property without
+ * copying them out of the realm or creating a [String]. This is useful when the value is only
+ * hashed, compared or written to a stream, e.g.
+ * `obj.useStringView(Item::description) { channel.write(it) }`.
+ *
+ * The view references the realm file directly and is only available for frozen objects. The
+ * version of the object is kept alive while [block] runs, but the view must not be retained or
+ * accessed after [block] returns, as the version can then be released and the memory it references
+ * reclaimed. Closing the realm inside [block] also invalidates the view.
+ *
+ * @param property the property to read, e.g. `Item::description`.
+ * @param block the function receiving the view or `null` if the value is `null`.
+ * @return the result of [block].
+ * @throws IllegalArgumentException if the object is unmanaged or the property is not a [String]
+ * property of the schema.
+ * @throws IllegalStateException if the object is not frozen, has been deleted or the realm has
+ * been closed.
+ */
+public fun <T : TypedRealmObject, R> T.useStringView(
+    property: KProperty1<T, String?>,
+    block: (ByteBuffer?) -> R
+): R {
+    val reference = realmObjectReference
+        ?: throw IllegalArgumentException("Cannot read a string view of an unmanaged object.")
+    val owner = reference.owner
+    if (owner !is FrozenRealmReference) {
+        throw IllegalStateException("String views are only available for frozen objects.")
+    }
+    owner.checkClosed()
+    reference.checkValid()
+    val propertyMetadata = reference.metadata[property.name]
+        ?: throw IllegalArgumentException("Schema doesn't contain a property named '${property.name}'")
+    if (propertyMetadata.collectionType != CollectionType.RLM_COLLECTION_TYPE_NONE ||
+        propertyMetadata.type != PropertyType.RLM_PROPERTY_TYPE_STRING
+    ) {
+        throw IllegalArgumentException("Property '${property.name}' is not a string property")
+    }
+    try {
+        return block(RealmInterop.realm_get_string_view(reference.objectPointer, propertyMetadata.key))
+    } finally {
+        // The buffer doesn't reference the realm, so the frozen reference could otherwise be
+        // reclaimed and its version closed by the `VersionTracker` while the view is in use.
+        // Locking it keeps it strongly reachable up to this point, as `Reference.reachabilityFence`
+        // is not available on Java 8 and older Android versions.
+        synchronized(owner) {}
+    }
+}
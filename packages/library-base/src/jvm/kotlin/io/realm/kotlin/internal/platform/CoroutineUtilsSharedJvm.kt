@@ -2,6 +2,7 @@
 
 package io.realm.kotlin.internal.platform
 
+import io.realm.kotlin.internal.interop.EventLoopDispatcher
 import kotlinx.coroutines.CloseableCoroutineDispatcher
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.ExperimentalCoroutinesApi
@@ -18,6 +19,12 @@ public actual fun singleThreadDispatcher(id: String): CloseableCoroutineDispatch
     }.asCoroutineDispatcher()
 }
 
+/**
+ * Returns a dispatcher running on a native event loop thread. Used as notification dispatcher it
+ * delivers notifications without hopping through a coroutine dispatcher. Only available on Linux.
+ */
+public fun eventLoopDispatcher(id: String): CloseableCoroutineDispatcher = EventLoopDispatcher(id)
+
 public actual fun multiThreadDispatcher(size: Int): CloseableCoroutineDispatcher =
     Executors.newFixedThreadPool(size).asCoroutineDispatcher()
 
@@ -526,6 +526,9 @@ public interface SyncConfiguration : Configuration {
                 partitionValue == null,
                 inMemory,
                 initialRealmFileConfiguration,
+                coalesceNotifications,
+                maxWriteGroupSize,
+                maxWriteGroupDuration,
                 realmLogger
             )
 
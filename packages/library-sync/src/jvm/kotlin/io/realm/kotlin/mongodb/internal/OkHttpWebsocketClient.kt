@@ -1,12 +1,15 @@
 package io.realm.kotlin.mongodb.internal
 
 import io.realm.kotlin.internal.ContextLogger
+import io.realm.kotlin.internal.interop.RealmInterop
 import io.realm.kotlin.internal.interop.RealmWebsocketHandlerCallbackPointer
+import io.realm.kotlin.internal.interop.sync.ByteBufferWebSocketClient
 import io.realm.kotlin.internal.interop.sync.WebSocketClient
 import io.realm.kotlin.internal.interop.sync.WebSocketObserver
 import io.realm.kotlin.internal.interop.sync.WebsocketCallbackResult
 import io.realm.kotlin.internal.interop.sync.WebsocketEngine
 import io.realm.kotlin.internal.interop.sync.WebsocketErrorCode
+import io.realm.kotlin.internal.interop.sync.onNewMessage
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.launch
 import okhttp3.OkHttpClient
@@ -16,6 +19,7 @@ import okhttp3.WebSocket
 import okhttp3.WebSocketListener
 import okio.ByteString
 import okio.ByteString.Companion.toByteString
+import java.nio.ByteBuffer
 import java.util.concurrent.TimeUnit
 import java.util.concurrent.atomic.AtomicBoolean
 import kotlin.random.Random
@@ -41,7 +45,7 @@ public class OkHttpWebsocketClient(
         status: WebsocketCallbackResult,
         reason: String
     ) -> Unit
-) : WebSocketClient, WebSocketListener() {
+) : ByteBufferWebSocketClient, WebSocketListener() {
 
     private val logger = ContextLogger("Websocket-${Random.nextInt()}")
 
@@ -66,6 +70,12 @@ public class OkHttpWebsocketClient(
 
     private val protocolSelectionHeader = "Sec-WebSocket-Protocol"
 
+    /**
+     * Direct buffer received messages are copied into, so Core can read them in place. Only
+     * accessed from the transport [scope].
+     */
+    private var receiveBuffer: ByteBuffer? = null
+
     init {
         val websocketURL = "${if (isSsl) "wss" else "ws"}://$address:$port$path"
         val request: Request = Request.Builder().url(websocketURL)
@@ -93,10 +103,16 @@ public class OkHttpWebsocketClient(
 
     override fun onMessage(webSocket: WebSocket, bytes: ByteString) {
         super.onMessage(webSocket, bytes)
-        logger.trace("onMessage: ${bytes.toByteArray().decodeToString()} isClosed = ${isClosed.get()} observerIsClosed = ${observerIsClosed.get()}")
+        logger.trace("onMessage: ${bytes.size} bytes isClosed = ${isClosed.get()} observerIsClosed = ${observerIsClosed.get()}")
 
         runIfObserverNotClosed {
-            val shouldClose: Boolean = observer.onNewMessage(bytes.toByteArray())
+            // Large messages are rare, so they are passed as a byte array instead of growing the
+            // retained buffer or allocating a direct buffer for each of them
+            val shouldClose: Boolean = if (bytes.size <= MAX_RECEIVE_BUFFER_SIZE) {
+                observer.onNewMessage(receiveBuffer(bytes))
+            } else {
+                observer.onNewMessage(bytes.toByteArray())
+            }
             if (shouldClose) {
                 webSocket.close(
                     WebsocketErrorCode.RLM_ERR_WEBSOCKET_OK.nativeValue,
@@ -151,31 +167,50 @@ public class OkHttpWebsocketClient(
 
     override fun send(message: ByteArray, handlerCallback: RealmWebsocketHandlerCallbackPointer) {
         logger.trace("send: ${message.decodeToString()} isClosed = ${isClosed.get()} observerIsClosed = ${observerIsClosed.get()}")
+        sendFrame({ message.toByteString() }) { cancelled, status, reason ->
+            runCallback(handlerCallback, cancelled, status, reason)
+        }
+    }
+
+    override fun send(message: ByteBuffer, writeId: Long) {
+        logger.trace("send: ${message.remaining()} bytes isClosed = ${isClosed.get()} observerIsClosed = ${observerIsClosed.get()}")
+        // The buffer wraps the Frame held by Core, which is freed with the websocket, so it is
+        // copied once into the Frame sent by OkHttp before returning
+        val frame = message.toByteString()
+        sendFrame({ frame }) { cancelled, _, _ ->
+            RealmInterop.realm_sync_socket_write_complete(writeId, cancelled)
+        }
+    }
 
+    /**
+     * Sends the Frame created by [frame] inside the transport [scope] and reports the result
+     * through [complete], which is invoked exactly once inside the [scope].
+     */
+    private fun sendFrame(
+        frame: () -> ByteString,
+        complete: (cancelled: Boolean, status: WebsocketCallbackResult, reason: String) -> Unit
+    ) {
         // send any queued Frames even if the Core observer is closed, but only if the websocket is still open, this can be a message like 'unbind'
         // which instruct the Sync server to terminate the Sync Session (server will respond by 'unbound').
         if (!isClosed.get()) {
             scope.launch {
                 try {
                     if (!isClosed.get()) { // double check that the websocket is still open before sending.
-                        webSocket.send(message.toByteString())
-                        runCallback(
-                            handlerCallback,
+                        webSocket.send(frame())
+                        complete(
                             observerIsClosed.get(), // if the Core observer is closed we run this callback as cancelled (to free underlying resources)
                             WebsocketCallbackResult.RLM_ERR_SYNC_SOCKET_SUCCESS,
                             ""
                         )
                     } else {
-                        runCallback(
-                            handlerCallback,
+                        complete(
                             observerIsClosed.get(), // if the Core observer is closed we run this callback as cancelled (to free underlying resources)
                             WebsocketCallbackResult.RLM_ERR_SYNC_SOCKET_CONNECTION_CLOSED,
                             "Connection already closed"
                         )
                     }
                 } catch (e: Exception) {
-                    runCallback(
-                        handlerCallback,
+                    complete(
                         observerIsClosed.get(), // if the Core observer is closed we run this callback as cancelled (to free underlying resources)
                         WebsocketCallbackResult.RLM_ERR_SYNC_SOCKET_RUNTIME,
                         "Sending Frame exception: ${e.message}"
@@ -184,8 +219,7 @@ public class OkHttpWebsocketClient(
             }
         } else {
             scope.launch {
-                runCallback(
-                    handlerCallback,
+                complete(
                     observerIsClosed.get(), // if the Core observer is closed we run this callback as cancelled (to free underlying resources)
                     WebsocketCallbackResult.RLM_ERR_SYNC_SOCKET_CONNECTION_CLOSED,
                     "Connection already closed"
@@ -209,6 +243,21 @@ public class OkHttpWebsocketClient(
         }
     }
 
+    /**
+     * Copies the message into the direct receive buffer, which grows up to
+     * [MAX_RECEIVE_BUFFER_SIZE].
+     */
+    private fun receiveBuffer(bytes: ByteString): ByteBuffer {
+        val buffer = receiveBuffer?.takeIf { it.capacity() >= bytes.size }
+            ?: ByteBuffer.allocateDirect(
+                minOf(bytes.size.takeHighestOneBit() shl 1, MAX_RECEIVE_BUFFER_SIZE)
+            ).also { receiveBuffer = it }
+        buffer.clear()
+        buffer.put(bytes.asByteBuffer())
+        buffer.flip()
+        return buffer
+    }
+
     /**
      * Runs the [block] inside the transport [scope] only if Core didn't initiate the Websocket closure.
      */
@@ -225,6 +274,8 @@ public class OkHttpWebsocketClient(
     }
 }
 
+private const val MAX_RECEIVE_BUFFER_SIZE = 1024 * 1024
+
 private class OkHttpEngine(timeoutMs: Long) : WebsocketEngine {
     private var engine: OkHttpClient =
         OkHttpClient.Builder()
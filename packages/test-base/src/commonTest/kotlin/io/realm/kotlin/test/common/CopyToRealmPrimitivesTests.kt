@@ -0,0 +1,180 @@
+/*
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.kotlin.test.common
+
+import io.realm.kotlin.Realm
+import io.realm.kotlin.RealmConfiguration
+import io.realm.kotlin.UpdatePolicy
+import io.realm.kotlin.entities.Sample
+import io.realm.kotlin.entities.SampleWithPrimaryKey
+import io.realm.kotlin.ext.query
+import io.realm.kotlin.test.platform.PlatformUtils
+import io.realm.kotlin.types.MutableRealmInt
+import io.realm.kotlin.types.RealmInstant
+import io.realm.kotlin.types.RealmUUID
+import org.mongodb.kbson.BsonObjectId
+import org.mongodb.kbson.Decimal128
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertContentEquals
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertNull
+
+/**
+ * Tests for copying the primitive properties of objects into the realm, which are set with a
+ * single C-API call.
+ */
+class CopyToRealmPrimitivesTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        val configuration = RealmConfiguration.Builder(setOf(Sample::class, SampleWithPrimaryKey::class))
+            .directory(tmpDir)
+            .build()
+        realm = Realm.open(configuration)
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (this::realm.isInitialized && !realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun allPrimitiveTypes() {
+        val objectId = BsonObjectId()
+        val uuid = RealmUUID.random()
+        realm.writeBlocking {
+            copyToRealm(
+                Sample().apply {
+                    stringField = "Realm ✓ 😀"
+                    byteField = Byte.MIN_VALUE
+                    charField = '￿'
+                    shortField = Short.MIN_VALUE
+                    intField = Int.MAX_VALUE
+                    longField = Long.MIN_VALUE
+                    booleanField = false
+                    floatField = Float.MAX_VALUE
+                    doubleField = Double.MIN_VALUE
+                    decimal128Field = Decimal128("-1.23E+45")
+                    timestampField = RealmInstant.from(-42, -999_999_999)
+                    bsonObjectIdField = objectId
+                    uuidField = uuid
+                    binaryField = byteArrayOf(0, 1, -1)
+                    mutableRealmIntField = MutableRealmInt.create(-7)
+                    nullableStringField = ""
+                    nullableLongField = 0
+                    nullableBooleanField = true
+                    nullableFloatField = Float.NaN
+                    nullableDoubleField = Double.NEGATIVE_INFINITY
+                    nullableBinaryField = byteArrayOf()
+                }
+            )
+        }
+        val sample = realm.query<Sample>().find().single()
+        assertEquals("Realm ✓ 😀", sample.stringField)
+        assertEquals(Byte.MIN_VALUE, sample.byteField)
+        assertEquals('￿', sample.charField)
+        assertEquals(Short.MIN_VALUE, sample.shortField)
+        assertEquals(Int.MAX_VALUE, sample.intField)
+        assertEquals(Long.MIN_VALUE, sample.longField)
+        assertEquals(false, sample.booleanField)
+        assertEquals(Float.MAX_VALUE, sample.floatField)
+        assertEquals(Double.MIN_VALUE, sample.doubleField)
+        assertEquals(Decimal128("-1.23E+45"), sample.decimal128Field)
+        assertEquals(RealmInstant.from(-42, -999_999_999), sample.timestampField)
+        assertEquals(objectId, sample.bsonObjectIdField)
+        assertEquals(uuid, sample.uuidField)
+        assertContentEquals(byteArrayOf(0, 1, -1), sample.binaryField)
+        assertEquals(-7, sample.mutableRealmIntField.get())
+        assertEquals("", sample.nullableStringField)
+        assertEquals(0, sample.nullableLongField)
+        assertEquals(true, sample.nullableBooleanField)
+        assertEquals(Float.NaN, sample.nullableFloatField)
+        assertEquals(Double.NEGATIVE_INFINITY, sample.nullableDoubleField)
+        assertContentEquals(byteArrayOf(), sample.nullableBinaryField)
+    }
+
+    @Test
+    fun nullValues() {
+        realm.writeBlocking {
+            copyToRealm(Sample())
+        }
+        val sample = realm.query<Sample>().find().single()
+        assertNull(sample.nullableStringField)
+        assertNull(sample.nullableByteField)
+        assertNull(sample.nullableCharField)
+        assertNull(sample.nullableShortField)
+        assertNull(sample.nullableIntField)
+        assertNull(sample.nullableLongField)
+        assertNull(sample.nullableBooleanField)
+        assertNull(sample.nullableFloatField)
+        assertNull(sample.nullableDoubleField)
+        assertNull(sample.nullableDecimal128Field)
+        assertNull(sample.nullableTimestampField)
+        assertNull(sample.nullableBsonObjectIdField)
+        assertNull(sample.nullableUUIDField)
+        assertNull(sample.nullableBinaryField)
+        assertNull(sample.nullableMutableRealmIntField)
+    }
+
+    @Test
+    fun updatePolicy_all() {
+        realm.writeBlocking {
+            copyToRealm(
+                SampleWithPrimaryKey().apply {
+                    primaryKey = 1
+                    stringField = "Initial"
+                    intField = 1
+                    nullableDoubleField = 1.0
+                }
+            )
+            copyToRealm(
+                SampleWithPrimaryKey().apply {
+                    primaryKey = 1
+                    stringField = "Updated"
+                    intField = 2
+                    nullableDoubleField = null
+                },
+                UpdatePolicy.ALL
+            )
+        }
+        val sample = realm.query<SampleWithPrimaryKey>().find().single()
+        assertEquals("Updated", sample.stringField)
+        assertEquals(2, sample.intField)
+        assertNull(sample.nullableDoubleField)
+    }
+
+    @Test
+    fun updatePolicy_error() {
+        realm.writeBlocking {
+            copyToRealm(SampleWithPrimaryKey().apply { stringField = "Initial" })
+            assertFailsWith<IllegalArgumentException> {
+                copyToRealm(SampleWithPrimaryKey().apply { stringField = "Updated" })
+            }
+        }
+        assertEquals("Initial", realm.query<SampleWithPrimaryKey>().find().single().stringField)
+    }
+}
@@ -100,4 +100,20 @@ class RealmResultsTests {
                 assertFailsWith<IllegalStateException> { results.version() }
             }
     }
+
+    @Test
+    fun iterator_acrossPages() {
+        val count = 600
+        realm.writeBlocking {
+            for (i in 0 until count) {
+                copyToRealm(Parent().apply { name = "$i" })
+            }
+        }
+        val results: RealmResults<Parent> = realm.query<Parent>().find()
+        assertEquals((0 until count).map { "$it" }, results.map { it.name })
+
+        val iterator = results.iterator()
+        repeat(count) { iterator.next() }
+        assertFailsWith<NoSuchElementException> { iterator.next() }
+    }
 }
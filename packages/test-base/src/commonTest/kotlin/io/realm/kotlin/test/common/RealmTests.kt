@@ -16,6 +16,7 @@
 package io.realm.kotlin.test.common
 
 import io.realm.kotlin.Configuration
+import io.realm.kotlin.MutableRealm
 import io.realm.kotlin.Realm
 import io.realm.kotlin.RealmConfiguration
 import io.realm.kotlin.VersionId
@@ -35,12 +36,19 @@ import io.realm.kotlin.test.platform.platformFileSystem
 import io.realm.kotlin.test.util.TestChannel
 import io.realm.kotlin.test.util.receiveOrFail
 import io.realm.kotlin.test.util.use
+import kotlinx.coroutines.CancellationException
+import kotlinx.coroutines.CompletableDeferred
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.CoroutineStart
+import kotlinx.coroutines.Deferred
 import kotlinx.coroutines.DelicateCoroutinesApi
 import kotlinx.coroutines.ExperimentalCoroutinesApi
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
 import kotlinx.coroutines.cancelAndJoin
 import kotlinx.coroutines.isActive
+import kotlinx.coroutines.job
 import kotlinx.coroutines.launch
 import kotlinx.coroutines.newSingleThreadContext
 import kotlinx.coroutines.runBlocking
@@ -59,7 +67,9 @@ import kotlin.test.assertIs
 import kotlin.test.assertNotNull
 import kotlin.test.assertTrue
 import kotlin.test.fail
+import kotlin.time.Duration
 import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.minutes
 
 class RealmTests {
 
@@ -400,6 +410,92 @@ class RealmTests {
         assertEquals(1, realm.query<Parent>().find().size)
     }
 
+    @Test
+    fun groupCommit_writesShareCommit() = runBlocking<Unit> {
+        Realm.open(groupCommitConfiguration()).use { realm ->
+            val initialVersion = realm.latestVersion()
+            val runs = IntArray(32)
+            whileWriterIsHeld(realm) {
+                (0 until 32).map { i ->
+                    queueWrite(realm) {
+                        runs[i]++
+                        copyToRealm(Parent().apply { name = "$i" })
+                    }
+                }
+            }.awaitAll().forEach { it.getOrThrow() }
+            assertEquals(32, realm.query<Parent>().count().find())
+            assertTrue(runs.all { it == 1 })
+            // The write holding the writer and two groups of 16 writes
+            assertEquals(initialVersion + 3, realm.latestVersion())
+        }
+    }
+
+    @Test
+    fun groupCommit_rejectsNonPositiveLimits() {
+        val builder = RealmConfiguration.Builder(setOf(Parent::class, Child::class))
+        assertFailsWithMessage<IllegalArgumentException>("Max writes must be positive") {
+            builder.groupCommit(maxWrites = 0, maxDuration = 1.minutes)
+        }
+        assertFailsWithMessage<IllegalArgumentException>("Max duration must be positive") {
+            builder.groupCommit(maxWrites = 16, maxDuration = Duration.ZERO)
+        }
+        assertFailsWithMessage<IllegalArgumentException>("Max duration must be positive") {
+            builder.groupCommit(maxWrites = 16, maxDuration = (-1).milliseconds)
+        }
+    }
+
+    @Test
+    fun groupCommit_failingWriteFailsAlone() = runBlocking<Unit> {
+        Realm.open(groupCommitConfiguration()).use { realm ->
+            val initialVersion = realm.latestVersion()
+            val runs = IntArray(16)
+            val results = whileWriterIsHeld(realm) {
+                (0 until 16).map { i ->
+                    queueWrite(realm) {
+                        runs[i]++
+                        if (i == 8) {
+                            throw IllegalStateException("Failing write")
+                        }
+                        copyToRealm(Parent().apply { name = "$i" })
+                    }
+                }
+            }.awaitAll()
+            assertEquals(listOf(8), results.indices.filter { results[it].isFailure })
+            assertEquals(15, realm.query<Parent>().count().find())
+            // The writes before the failing write are rolled back with it and run again on their
+            // own, while the writes after it are only run once in the next group
+            assertEquals(List(8) { 2 } + List(8) { 1 }, runs.toList())
+            // The write holding the writer, the eight writes run on their own and the group of
+            // writes after the failing write
+            assertEquals(initialVersion + 10, realm.latestVersion())
+        }
+    }
+
+    @Test
+    fun groupCommit_cancelledWritesAreNotCommitted() = runBlocking<Unit> {
+        Realm.open(groupCommitConfiguration()).use { realm ->
+            val writes = whileWriterIsHeld(realm) {
+                (0 until 100).map { i ->
+                    async(start = CoroutineStart.UNDISPATCHED) {
+                        val caller = coroutineContext.job
+                        realm.write {
+                            copyToRealm(Parent().apply { name = "$i" })
+                            // Cancelled after the block has been applied but before it is committed
+                            if (i % 10 == 0) {
+                                caller.cancel()
+                            }
+                        }
+                    }
+                }
+            }
+            val results = writes.map { runCatching { it.await() } }
+            assertEquals(10, results.count { it.exceptionOrNull() is CancellationException })
+            assertEquals(90, realm.query<Parent>().count().find())
+            val cancelledNames = (0 until 100 step 10).map { "$it" }
+            assertEquals(0, realm.query<Parent>("name IN $0", cancelledNames).count().find())
+        }
+    }
+
     @OptIn(ExperimentalCoroutinesApi::class)
     @Test
     @Suppress("invisible_member")
@@ -565,6 +661,50 @@ class RealmTests {
         return builder.build()
     }
 
+    // Configuration of another realm in the directory of the test committing writes in groups of
+    // up to 16 writes
+    private fun groupCommitConfiguration(): RealmConfiguration =
+        RealmConfiguration.Builder(setOf(Parent::class, Child::class))
+            .directory(tmpDir)
+            .name("group-commit.realm")
+            .groupCommit(maxWrites = 16, maxDuration = 1.minutes)
+            .build()
+
+    // Occupies the writer of the realm while submitting writes, so all writes submitted by the
+    // block are queued before the first of them is committed
+    private suspend fun <T> CoroutineScope.whileWriterIsHeld(realm: Realm, block: () -> T): T {
+        val held = CompletableDeferred<Unit>()
+        val release = CompletableDeferred<Unit>()
+        val holder = async {
+            realm.write {
+                runBlocking {
+                    held.complete(Unit)
+                    release.await()
+                }
+            }
+        }
+        held.await()
+        return try {
+            block()
+        } finally {
+            release.complete(Unit)
+            holder.await()
+        }
+    }
+
+    // Submits a write and returns once it is queued by the writer. The outcome of the write is
+    // returned instead of failing the scope.
+    private fun <R> CoroutineScope.queueWrite(
+        realm: Realm,
+        block: MutableRealm.() -> R
+    ): Deferred<Result<R>> = async(start = CoroutineStart.UNDISPATCHED) {
+        runCatching { realm.write(block) }
+    }
+
+    // Latest version committed to the realm
+    private suspend fun Realm.latestVersion(): Long =
+        write { version().version.also { cancelWrite() } }
+
     private fun writeCopy(from: Configuration, to: Configuration) {
         Realm.open(from).use { realm ->
             realm.writeBlocking {
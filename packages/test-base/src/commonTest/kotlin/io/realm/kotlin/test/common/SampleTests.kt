@@ -23,6 +23,7 @@ package io.realm.kotlin.test.common
 import io.realm.kotlin.Realm
 import io.realm.kotlin.RealmConfiguration
 import io.realm.kotlin.entities.Sample
+import io.realm.kotlin.ext.column
 import io.realm.kotlin.ext.query
 import io.realm.kotlin.ext.realmListOf
 import io.realm.kotlin.ext.toRealmList
@@ -336,4 +337,74 @@ class SampleTests {
             assertContentEquals(intList, sample.intListField)
         }
     }
+
+    @Test
+    fun frozenObject_readsAllProperties() {
+        val expected = Sample().apply {
+            stringField = "Frozen"
+            intField = 7
+            nullableLongField = 8
+            floatField = 1.5f
+            doubleField = 2.5
+            decimal128Field = Decimal128("1.5")
+            timestampField = RealmInstant.from(42, 420)
+            nullableBinaryField = byteArrayOf(1, 2, 3)
+        }
+        realm.writeBlocking { copyToRealm(expected) }
+
+        val sample = realm.query<Sample>().find().single()
+        assertEquals(expected.stringField, sample.stringField)
+        assertEquals(expected.intField, sample.intField)
+        assertEquals(expected.nullableLongField, sample.nullableLongField)
+        assertEquals(null, sample.nullableStringField)
+        assertEquals(expected.floatField, sample.floatField)
+        assertEquals(expected.doubleField, sample.doubleField)
+        assertEquals(expected.decimal128Field, sample.decimal128Field)
+        assertEquals(expected.timestampField, sample.timestampField)
+        assertEquals(expected.bsonObjectIdField, sample.bsonObjectIdField)
+        assertEquals(expected.uuidField, sample.uuidField)
+        assertContentEquals(expected.nullableBinaryField, sample.nullableBinaryField)
+    }
+
+    @Test
+    fun frozenObject_readAfterCloseThrows() {
+        realm.writeBlocking { copyToRealm(Sample()) }
+        val sample = realm.query<Sample>().find().single()
+        assertEquals("Realm", sample.stringField)
+        realm.close()
+        assertFailsWith<IllegalStateException> {
+            sample.stringField
+        }
+    }
+
+    @Test
+    fun results_column() {
+        realm.writeBlocking {
+            for (i in 0 until 10) {
+                copyToRealm(
+                    Sample().apply {
+                        intField = i
+                        doubleField = i * 1.5
+                        nullableLongField = if (i % 2 == 0) i.toLong() else null
+                    }
+                )
+            }
+        }
+        val results = realm.query<Sample>().find()
+
+        val ints = results.column(Sample::intField)
+        assertEquals(10, ints.size)
+        assertContentEquals((0L until 10L).toList(), ints.values.toList())
+
+        val doubles = results.column(Sample::doubleField)
+        assertContentEquals((0 until 10).map { it * 1.5 }, doubles.values.toList())
+
+        val nullableLongs = results.column(Sample::nullableLongField)
+        for (i in 0 until 10) {
+            assertEquals(i % 2 != 0, nullableLongs.isNull(i))
+            if (!nullableLongs.isNull(i)) {
+                assertEquals(i.toLong(), nullableLongs.values[i])
+            }
+        }
+    }
 }
@@ -21,6 +21,7 @@ import io.realm.kotlin.RealmConfiguration
 import io.realm.kotlin.VersionId
 import io.realm.kotlin.entities.Sample
 import io.realm.kotlin.ext.asFlow
+import io.realm.kotlin.ext.query
 import io.realm.kotlin.internal.platform.runBlocking
 import io.realm.kotlin.notifications.InitialRealm
 import io.realm.kotlin.notifications.RealmChange
@@ -129,6 +130,41 @@ class RealmNotificationsTests : FlowableTests {
         c2.cancel()
     }
 
+    @Test
+    fun registrationsNotifiedByTheSameCommit() = runBlocking {
+        withTimeout(30.seconds) {
+            val c1 = TestChannel<Int>()
+            val c2 = TestChannel<Int>()
+            val observer1 = async {
+                realm.query<Sample>("intField == 1").asFlow().collect { c1.send(it.list.size) }
+            }
+            val observer2 = async {
+                realm.query<Sample>("intField == 2").asFlow().collect { c2.send(it.list.size) }
+            }
+            assertEquals(0, c1.receiveOrFail())
+            assertEquals(0, c2.receiveOrFail())
+
+            // Both notifications are triggered by the same scheduler pass
+            realm.write {
+                copyToRealm(Sample().apply { intField = 1 })
+                copyToRealm(Sample().apply { intField = 2 })
+            }
+            assertEquals(1, c1.receiveOrFail())
+            assertEquals(1, c2.receiveOrFail())
+
+            // Removing a registration while the other one is still notified
+            observer2.cancel()
+            realm.write {
+                copyToRealm(Sample().apply { intField = 1 })
+            }
+            assertEquals(2, c1.receiveOrFail())
+            observer1.cancel()
+            c1.close()
+            c2.close()
+        }
+        Unit
+    }
+
     @Test
     override fun asFlow() {
         runBlocking {
@@ -43,6 +43,7 @@ import kotlin.test.BeforeTest
 import kotlin.test.Ignore
 import kotlin.test.Test
 import kotlin.test.assertContains
+import kotlin.test.assertContentEquals
 import kotlin.test.assertEquals
 import kotlin.test.assertFailsWith
 import kotlin.test.assertIs
@@ -476,6 +477,35 @@ class RealmObjectNotificationsTests : RealmEntityNotificationTests {
         c.close()
     }
 
+    @Test
+    fun keyPath_changesOutsideOfKeyPathAreNotDelivered() = runBlocking<Unit> {
+        val c = Channel<ObjectChange<Sample>>(1)
+        val obj: Sample = realm.write {
+            copyToRealm(Sample().apply { stringField = "observed" })
+        }
+        val observer = async {
+            obj.asFlow(listOf("stringField")).collect {
+                c.trySend(it)
+            }
+        }
+        assertIs<InitialObject<Sample>>(c.receiveOrFail())
+        realm.write {
+            // Neither touches the observed key path, so must not result in a notification
+            findLatest(obj)!!.nullableObject = copyToRealm(Sample())
+            copyToRealm(Sample().apply { stringField = "other" })
+        }
+        realm.write {
+            findLatest(obj)!!.stringField = "updated"
+        }
+        c.receiveOrFail().let { objectChange ->
+            assertIs<UpdatedObject<Sample>>(objectChange)
+            assertEquals("updated", objectChange.obj.stringField)
+            assertContentEquals(arrayOf("stringField"), objectChange.changedFields)
+        }
+        observer.cancel()
+        c.close()
+    }
+
     @Test
     override fun keyPath_unknownTopLevelProperty() = runBlocking<Unit> {
         val obj: Sample = realm.write { copyToRealm(Sample()) }
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.kotlin.test.jvm
+
+import io.realm.kotlin.Realm
+import io.realm.kotlin.RealmConfiguration
+import io.realm.kotlin.entities.Sample
+import io.realm.kotlin.internal.RealmImpl
+import io.realm.kotlin.internal.interop.RealmInterop
+import io.realm.kotlin.internal.interop.RealmKeyPathArrayPointer
+import io.realm.kotlin.test.platform.PlatformUtils
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertFalse
+import kotlin.test.assertTrue
+
+/**
+ * Tests of the native cache sharing resolved key path arrays between notification registrations,
+ * see `KeyPathArrayCache` in `realm_api_helpers.cpp`.
+ */
+@Suppress("invisible_member", "invisible_reference")
+class KeyPathArrayCacheTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var configuration: RealmConfiguration
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        configuration = RealmConfiguration.Builder(setOf(Sample::class))
+            .directory(tmpDir)
+            .build()
+        realm = Realm.open(configuration)
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (this::realm.isInitialized && !realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun sameKeyPathsShareArray() {
+        val keyPaths = keyPaths("stringField", "nullableObject.intField")
+        assertTrue(shared(keyPaths, keyPaths("stringField", "nullableObject.intField")))
+        assertFalse(shared(keyPaths, keyPaths("stringField")))
+    }
+
+    @Test
+    fun keyPathsAreNormalized() {
+        val keyPaths = keyPaths("stringField", "nullableObject.intField")
+        assertTrue(shared(keyPaths, keyPaths("nullableObject.intField", "stringField")))
+        assertTrue(shared(keyPaths, keyPaths("stringField", "nullableObject.intField", "stringField")))
+    }
+
+    @Test
+    fun wildcardsAreNotCached() {
+        assertFalse(shared(keyPaths("*"), keyPaths("*")))
+        assertFalse(shared(keyPaths("nullableObject.*"), keyPaths("nullableObject.*")))
+    }
+
+    @Test
+    fun emptyKeyPathsAreNotCached() {
+        assertFalse(shared(keyPaths(), keyPaths()))
+    }
+
+    @Test
+    fun reopenedRealmDoesNotShareArray() {
+        val keyPaths = keyPaths("stringField")
+        realm.close()
+        realm = Realm.open(configuration)
+        assertFalse(shared(keyPaths, keyPaths("stringField")))
+    }
+
+    @Test
+    fun recreatedRealmDoesNotShareArray() {
+        val keyPaths = keyPaths("stringField")
+        realm.close()
+        Realm.deleteRealm(configuration)
+        realm = Realm.open(configuration)
+        val recreated = keyPaths("stringField")
+        assertFalse(shared(keyPaths, recreated))
+        assertTrue(shared(recreated, keyPaths("stringField")))
+    }
+
+    private fun keyPaths(vararg keyPaths: String): RealmKeyPathArrayPointer {
+        val reference = (realm as RealmImpl).realmReference
+        return RealmInterop.realm_create_key_paths_array(
+            reference.dbPointer,
+            reference.schemaMetadata.getOrThrow("Sample").classKey,
+            keyPaths.toList()
+        )
+    }
+
+    private fun shared(keyPaths: RealmKeyPathArrayPointer, other: RealmKeyPathArrayPointer): Boolean =
+        RealmInterop.realm_key_path_arrays_shared_for_testing(keyPaths, other)
+}
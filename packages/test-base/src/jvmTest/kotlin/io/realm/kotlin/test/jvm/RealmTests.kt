@@ -22,12 +22,25 @@ import io.realm.kotlin.Realm
 import io.realm.kotlin.RealmConfiguration
 import io.realm.kotlin.entities.link.Child
 import io.realm.kotlin.entities.link.Parent
+import io.realm.kotlin.ext.query
+import io.realm.kotlin.ext.useStringView
+import io.realm.kotlin.notifications.InitialResults
+import io.realm.kotlin.notifications.UpdatedResults
+import io.realm.kotlin.internal.interop.LongPointerWrapper
+import io.realm.kotlin.internal.interop.NotificationCallback
+import io.realm.kotlin.internal.interop.NotificationMultiplexer
+import io.realm.kotlin.internal.interop.RealmInterop
+import io.realm.kotlin.internal.interop.realm_value_type_e
+import io.realm.kotlin.internal.interop.realmc
+import io.realm.kotlin.internal.platform.eventLoopDispatcher
 import io.realm.kotlin.internal.platform.singleThreadDispatcher
+import io.realm.kotlin.internal.realmObjectReference
 import io.realm.kotlin.test.platform.PlatformUtils
 import io.realm.kotlin.test.util.TestChannel
 import io.realm.kotlin.test.util.receiveOrFail
 import io.realm.kotlin.test.util.use
 import kotlinx.coroutines.CloseableCoroutineDispatcher
+import kotlinx.coroutines.CompletableDeferred
 import kotlinx.coroutines.ExperimentalCoroutinesApi
 import kotlinx.coroutines.async
 import kotlinx.coroutines.delay
@@ -35,10 +48,20 @@ import kotlinx.coroutines.flow.first
 import kotlinx.coroutines.launch
 import kotlinx.coroutines.runBlocking
 import kotlinx.coroutines.withTimeout
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.util.Collections
+import java.util.concurrent.CountDownLatch
+import java.util.concurrent.TimeUnit
+import kotlin.coroutines.EmptyCoroutineContext
 import kotlin.random.Random
 import kotlin.random.nextUInt
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
 import kotlin.test.Test
+import kotlin.test.assertContentEquals
 import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
 import kotlin.test.assertTrue
 import kotlin.test.fail
 import kotlin.time.Duration.Companion.seconds
@@ -50,6 +73,18 @@ fun totalThreadCount() = Thread.getAllStackTraces().size
  */
 class RealmTests {
 
+    private lateinit var tmpDir: String
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+    }
+
+    @AfterTest
+    fun tearDown() {
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
     // Test for https://github.com/Kotlin/kotlinx.coroutines/issues/3993
     @Test
     fun submittingToClosedDispatcherIsANoop() {
@@ -143,6 +178,302 @@ class RealmTests {
         }
     }
 
+    @Test
+    fun useStringView() {
+        Realm.open(configuration()).use { realm ->
+            realm.writeBlocking {
+                copyToRealm(Parent().apply { name = "Jürgen" })
+            }
+            val parent = realm.query<Parent>().find().single()
+            val decoded = parent.useStringView(Parent::name) { view ->
+                assertTrue(view!!.isReadOnly)
+                Charsets.UTF_8.decode(view).toString()
+            }
+            assertEquals("Jürgen", decoded)
+
+            realm.writeBlocking {
+                assertFailsWith<IllegalStateException> {
+                    findLatest(parent)!!.useStringView(Parent::name) { }
+                }
+            }
+            assertFailsWith<IllegalArgumentException> {
+                Parent().useStringView(Parent::name) { }
+            }
+        }
+    }
+
+    @Test
+    fun copyToRealm_invalidSurrogatesThrows() {
+        Realm.open(configuration()).use { realm ->
+            listOf("\uD800", "a\uDC00b", "\uDC00\uD800").forEach { invalid ->
+                assertFailsWith<IllegalArgumentException> {
+                    realm.writeBlocking {
+                        copyToRealm(Parent().apply { name = invalid })
+                    }
+                }
+            }
+            assertEquals(0, realm.query<Parent>().count().find())
+        }
+    }
+
+    @Test
+    @Suppress("invisible_reference", "invisible_member")
+    fun setValuesPacked_truncatedBufferThrows() {
+        val configuration = RealmConfiguration.Builder(setOf(Parent::class, Child::class))
+            .directory(PlatformUtils.createTempDir())
+            .build()
+        Realm.open(configuration).use { realm ->
+            realm.writeBlocking {
+                val parent = copyToRealm(Parent())
+                val pointer = (parent.realmObjectReference!!.objectPointer as LongPointerWrapper<*>).ptr
+                // A property key followed by a string claiming more bytes than the buffer holds
+                val buffer = ByteBuffer.allocateDirect(16).order(ByteOrder.nativeOrder())
+                    .putLong(0)
+                    .putInt(realm_value_type_e.RLM_TYPE_STRING)
+                    .putInt(1024)
+                assertFailsWith<IllegalArgumentException> {
+                    realmc.realm_set_values_packed(pointer, 1, buffer, buffer.position().toLong(), false)
+                }
+            }
+        }
+    }
+
+    @Test
+    @Suppress("invisible_reference", "invisible_member")
+    fun eventLoopNotificationDispatcher() = runBlocking {
+        if (!System.getProperty("os.name").startsWith("Linux")) {
+            return@runBlocking
+        }
+        withTimeout(30.seconds) {
+            val notificationDispatcher = eventLoopDispatcher("custom-event-loop")
+            Realm.open(configuration { notificationDispatcher(notificationDispatcher) }).use { realm ->
+                val update = async {
+                    realm.query<Parent>().asFlow().first { it.list.isNotEmpty() }
+                }
+                realm.write {
+                    copyToRealm(Parent().apply { name = "event-loop" })
+                }
+                assertEquals("event-loop", update.await().list.single().name)
+            }
+            notificationDispatcher.close()
+        }
+    }
+
+    @Test
+    fun notificationMultiplexer_failingCallback() {
+        val delivered = mutableListOf<Int>()
+        val callbacks = Array<NotificationCallback>(3) { i ->
+            object : NotificationCallback {
+                override fun onChange(pointer: Long) {
+                    if (i == 1) {
+                        throw IllegalStateException("Failing callback")
+                    }
+                    delivered.add(i)
+                }
+            }
+        }
+        // The failure is rethrown after the remaining callbacks have been notified
+        assertFailsWith<IllegalStateException> {
+            NotificationMultiplexer.onChanges(callbacks, LongArray(3))
+        }
+        assertEquals(listOf(0, 2), delivered)
+    }
+
+    @Test
+    fun eventLoopDispatcher_closeWithQueuedBlocks() {
+        if (!System.getProperty("os.name").startsWith("Linux")) {
+            return
+        }
+        val dispatcher = eventLoopDispatcher("closing-event-loop")
+        val started = CountDownLatch(1)
+        val queued = CountDownLatch(1)
+        val completed = CountDownLatch(10)
+        val threads = Collections.synchronizedList(mutableListOf<String>())
+        // Closes the loop from its own thread while the other blocks are still queued behind it
+        dispatcher.dispatch(EmptyCoroutineContext) {
+            started.countDown()
+            queued.await()
+            dispatcher.close()
+        }
+        assertTrue(started.await(10, TimeUnit.SECONDS))
+        repeat(10) {
+            dispatcher.dispatch(EmptyCoroutineContext) {
+                threads.add(Thread.currentThread().name)
+                completed.countDown()
+            }
+        }
+        queued.countDown()
+        assertTrue(completed.await(10, TimeUnit.SECONDS))
+        assertTrue(threads.none { it == "closing-event-loop" })
+    }
+
+    @Test
+    fun eventLoopDispatcher_closeWithinBatch() {
+        if (!System.getProperty("os.name").startsWith("Linux")) {
+            return
+        }
+        val dispatcher = eventLoopDispatcher("batch-closing-event-loop")
+        val started = CountDownLatch(1)
+        val queued = CountDownLatch(1)
+        val completed = CountDownLatch(10)
+        val threads = Collections.synchronizedList(mutableListOf<String>())
+        dispatcher.dispatch(EmptyCoroutineContext) {
+            started.countDown()
+            queued.await()
+        }
+        assertTrue(started.await(10, TimeUnit.SECONDS))
+        // Queued while the loop is busy, so the closing block and the blocks behind it are taken
+        // as one batch
+        dispatcher.dispatch(EmptyCoroutineContext) { dispatcher.close() }
+        repeat(10) {
+            dispatcher.dispatch(EmptyCoroutineContext) {
+                threads.add(Thread.currentThread().name)
+                completed.countDown()
+            }
+        }
+        queued.countDown()
+        assertTrue(completed.await(10, TimeUnit.SECONDS))
+        assertTrue(threads.none { it == "batch-closing-event-loop" })
+    }
+
+    @Test
+    fun coalesceNotifications() = runBlocking {
+        Realm.open(configuration { coalesceNotifications(true) }).use { realm ->
+            withTimeout(30.seconds) {
+                val initialReceived = CompletableDeferred<Unit>()
+                val collectorBlocked = CompletableDeferred<Unit>()
+                val writesDone = CompletableDeferred<Unit>()
+                val sizes = mutableListOf<Int>()
+                val observer = async {
+                    realm.query<Parent>().asFlow().first { change ->
+                        sizes.add(change.list.size)
+                        when (change.list.size) {
+                            0 -> initialReceived.complete(Unit)
+                            1 -> {
+                                collectorBlocked.complete(Unit)
+                                writesDone.await()
+                            }
+                        }
+                        change.list.size == 5
+                    }
+                }
+                initialReceived.await()
+                realm.write { copyToRealm(Parent()) }
+                collectorBlocked.await()
+                repeat(4) {
+                    realm.write { copyToRealm(Parent()) }
+                }
+                writesDone.complete(Unit)
+                observer.await()
+                // All writes committed while the collector was busy are delivered as one change
+                assertEquals(listOf(0, 1, 5), sizes)
+            }
+        }
+    }
+
+    @Test
+    fun coalesceNotifications_mergedIndices() = runBlocking {
+        Realm.open(configuration { coalesceNotifications(true) }).use { realm ->
+            withTimeout(30.seconds) {
+                realm.write {
+                    copyToRealm(Parent().apply { name = "B" })
+                    copyToRealm(Parent().apply { name = "C" })
+                }
+                val collectorBlocked = CompletableDeferred<Unit>()
+                val writesDone = CompletableDeferred<Unit>()
+                val observer = async {
+                    realm.query<Parent>().sort("name").asFlow().first { change ->
+                        if (change is InitialResults) {
+                            collectorBlocked.complete(Unit)
+                            writesDone.await()
+                        }
+                        change is UpdatedResults
+                    } as UpdatedResults<Parent>
+                }
+                collectorBlocked.await()
+                realm.write { copyToRealm(Parent().apply { name = "A" }) }
+                // Inserts before the modified row, so its index differs between the old and the
+                // new results of this change
+                realm.write {
+                    copyToRealm(Parent().apply { name = "0" })
+                    query<Parent>("name == 'C'").find().single().name = "D"
+                }
+                writesDone.complete(Unit)
+                val change = observer.await()
+                assertEquals(listOf("0", "A", "B", "D"), change.list.map { it.name })
+                assertContentEquals(intArrayOf(), change.deletions)
+                assertContentEquals(intArrayOf(0, 1), change.insertions)
+                assertContentEquals(intArrayOf(3), change.changes)
+                assertEquals(listOf(3), change.changeRanges.map { it.startIndex })
+                assertEquals(listOf(1), change.changeRanges.map { it.length })
+            }
+        }
+    }
+
+    @Test
+    @Suppress("invisible_reference", "invisible_member")
+    fun schedulerNotificationsAreCoalesced() = runBlocking {
+        val notificationDispatcher = singleThreadDispatcher("coalescing-notifier")
+        Realm.open(configuration { notificationDispatcher(notificationDispatcher) }).use { realm ->
+            withTimeout(30.seconds) {
+                val sizes = TestChannel<Int>()
+                val observer = async {
+                    realm.query<Parent>().asFlow().collect { sizes.send(it.list.size) }
+                }
+                assertEquals(0, sizes.receiveOrFail())
+
+                // Blocks the dispatcher, so the upcall for the first commit stays pending and the
+                // notifications of the following commits are folded into it
+                val release = CountDownLatch(1)
+                notificationDispatcher.dispatch(EmptyCoroutineContext) { release.await() }
+                val coalesced = RealmInterop.realm_scheduler_coalesced_notifications()
+                repeat(5) {
+                    realm.write { copyToRealm(Parent()) }
+                }
+                while (RealmInterop.realm_scheduler_coalesced_notifications() == coalesced) {
+                    delay(10)
+                }
+                release.countDown()
+
+                // The coalesced notifications still deliver all commits
+                do {
+                    val size = sizes.receiveOrFail()
+                } while (size != 5)
+                observer.cancel()
+                sizes.close()
+            }
+        }
+        notificationDispatcher.close()
+    }
+
+    @Test
+    fun notificationLatencyStats() = runBlocking<Unit> {
+        Realm.open(configuration()).use { realm ->
+            val before = RealmInterop.realm_get_notification_latency_stats()
+            val update = async {
+                realm.query<Parent>().asFlow().first { it.list.isNotEmpty() }
+            }
+            // Commits before the registration is active are not observed, so keep writing
+            withTimeout(30.seconds) {
+                while (!update.isCompleted) {
+                    realm.write { copyToRealm(Parent()) }
+                    delay(10)
+                }
+            }
+            val after = RealmInterop.realm_get_notification_latency_stats()
+            assertTrue(after.commitToCallback.count > before.commitToCallback.count)
+            assertTrue(after.commitToCallback.p50 <= after.commitToCallback.max)
+        }
+    }
+
+    // Configuration of a realm in the temporary directory of the test
+    private fun configuration(
+        block: RealmConfiguration.Builder.() -> Unit = {}
+    ): RealmConfiguration = RealmConfiguration.Builder(setOf(Parent::class, Child::class))
+        .directory(tmpDir)
+        .apply(block)
+        .build()
+
     private fun threadTrace(): String {
         val sb = StringBuilder()
         sb.appendLine("--------------------------------")
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.kotlin.test.jvm
+
+import io.realm.kotlin.internal.interop.RealmInterop
+import io.realm.kotlin.internal.interop.RealmWebsocketHandlerCallbackPointer
+import io.realm.kotlin.internal.interop.realmc
+import io.realm.kotlin.internal.interop.sync.CancellableTimer
+import io.realm.kotlin.internal.interop.sync.WebSocketClient
+import io.realm.kotlin.internal.interop.sync.WebSocketObserver
+import io.realm.kotlin.internal.interop.sync.WebSocketTransport
+import java.util.concurrent.CountDownLatch
+import java.util.concurrent.ExecutorService
+import java.util.concurrent.Executors
+import java.util.concurrent.TimeUnit
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+import kotlin.test.fail
+
+/**
+ * Tests of the native queue holding the handlers and timers of the sync client until they are run
+ * on the event loop of the transport, see `SyncEventQueue` in `realm_api_helpers.cpp`. The queue
+ * records the completions of handlers and timers identified by an id instead of completing them
+ * for a sync client.
+ */
+class SyncEventQueueTests {
+
+    private lateinit var transport: EventLoopTransport
+    private var queue: Long = 0
+
+    @BeforeTest
+    fun setup() {
+        transport = EventLoopTransport()
+        queue = realmc.realm_sync_event_queue_new_for_testing(transport)
+    }
+
+    @AfterTest
+    fun tearDown() {
+        realmc.realm_sync_event_queue_free_for_testing(queue)
+        transport.close()
+    }
+
+    @Test
+    fun postedHandlersRunInOrder() {
+        repeat(100) { realmc.realm_sync_event_queue_post_for_testing(queue, it.toLong()) }
+        assertEquals((0L until 100L).map { it to false }, awaitCompletions(100))
+    }
+
+    @Test
+    fun timersExpireInDeadlineOrder() {
+        // Spans the first two levels of the wheel
+        listOf(80L to 1L, 20L to 2L, 300L to 3L, 40L to 4L, 0L to 5L).forEach { (delay, id) ->
+            realmc.realm_sync_event_queue_schedule_for_testing(queue, delay, id)
+        }
+        assertEquals(listOf(5L, 2L, 4L, 1L, 3L).map { it to false }, awaitCompletions(5))
+    }
+
+    @Test
+    fun cancelledTimersCompleteAsCancelled() {
+        val timer = realmc.realm_sync_event_queue_schedule_for_testing(queue, 60_000, 1)
+        realmc.realm_sync_event_queue_schedule_for_testing(queue, 60_000, 2)
+        realmc.realm_sync_event_queue_cancel_for_testing(queue, timer)
+        assertEquals(listOf(1L to true), awaitCompletions(1))
+
+        // Cancelling a completed timer is a no-op
+        realmc.realm_sync_event_queue_cancel_for_testing(queue, timer)
+        Thread.sleep(50)
+        assertEquals(emptyList(), takeCompletions())
+    }
+
+    @Test
+    fun farFutureTimersDoNotExpire() {
+        // Beyond the range of the highest level of the wheel
+        realmc.realm_sync_event_queue_schedule_for_testing(queue, 1L shl 30, 1)
+        realmc.realm_sync_event_queue_schedule_for_testing(queue, 10, 2)
+        assertEquals(listOf(2L to false), awaitCompletions(1))
+        Thread.sleep(50)
+        assertEquals(emptyList(), takeCompletions())
+
+        realmc.realm_sync_event_queue_close_for_testing(queue)
+        assertEquals(listOf(1L to true), awaitCompletions(1))
+    }
+
+    @Test
+    fun closeCompletesPendingWorkAsCancelled() {
+        // Holds the event loop, so the pass for the handlers is still pending when closing
+        val release = CountDownLatch(1)
+        transport.executor.execute { release.await() }
+        realmc.realm_sync_event_queue_schedule_for_testing(queue, 60_000, 1)
+        realmc.realm_sync_event_queue_post_for_testing(queue, 2)
+        realmc.realm_sync_event_queue_post_for_testing(queue, 3)
+        realmc.realm_sync_event_queue_close_for_testing(queue)
+        release.countDown()
+        assertEquals(
+            setOf(1L to true, 2L to true, 3L to true),
+            awaitCompletions(3).toSet()
+        )
+
+        // Handlers posted after closing are cancelled right away
+        realmc.realm_sync_event_queue_post_for_testing(queue, 4)
+        assertEquals(listOf(4L to true), takeCompletions())
+        Thread.sleep(50)
+        assertEquals(emptyList(), takeCompletions())
+    }
+
+    @Test
+    fun driverThreadIsDetachedOnClose() {
+        val before = RealmInterop.realm_get_jni_thread_stats()
+        // The driver thread attaches itself to the JVM when started and is joined when closing
+        val other = realmc.realm_sync_event_queue_new_for_testing(transport)
+        realmc.realm_sync_event_queue_free_for_testing(other)
+        val after = RealmInterop.realm_get_jni_thread_stats()
+        assertTrue(after.attached > before.attached, "Not attached: $before -> $after")
+        assertTrue(after.detached > before.detached, "Not detached: $before -> $after")
+    }
+
+    private fun takeCompletions(): List<Pair<Long, Boolean>> =
+        realmc.realm_sync_event_queue_completions_for_testing(queue).toList()
+            .chunked(2) { (id, cancelled) -> id to (cancelled == 1L) }
+
+    private fun awaitCompletions(count: Int): List<Pair<Long, Boolean>> {
+        val completions = mutableListOf<Pair<Long, Boolean>>()
+        val deadline = System.nanoTime() + TimeUnit.SECONDS.toNanos(10)
+        while (completions.size < count) {
+            if (System.nanoTime() > deadline) {
+                fail("Only completed $completions")
+            }
+            completions.addAll(takeCompletions())
+            Thread.sleep(1)
+        }
+        assertTrue(completions.size == count, "Completed more than expected: $completions")
+        return completions
+    }
+
+    /**
+     * Transport running the passes of the queue on a single thread like the event loop of the
+     * sync client.
+     */
+    private class EventLoopTransport : WebSocketTransport {
+        val executor: ExecutorService = Executors.newSingleThreadExecutor()
+
+        override fun post(handlerCallback: RealmWebsocketHandlerCallbackPointer) {
+            executor.execute { runCallback(handlerCallback) }
+        }
+
+        override fun createTimer(
+            delayInMilliseconds: Long,
+            handlerCallback: RealmWebsocketHandlerCallbackPointer
+        ): CancellableTimer = throw UnsupportedOperationException()
+
+        override fun connect(
+            observer: WebSocketObserver,
+            path: String,
+            address: String,
+            port: Long,
+            isSsl: Boolean,
+            numProtocols: Long,
+            supportedSyncProtocols: String
+        ): WebSocketClient = throw UnsupportedOperationException()
+
+        override fun write(
+            webSocketClient: WebSocketClient,
+            data: ByteArray,
+            length: Long,
+            handlerCallback: RealmWebsocketHandlerCallbackPointer
+        ) = throw UnsupportedOperationException()
+
+        override fun close() {
+            executor.shutdown()
+        }
+    }
+}
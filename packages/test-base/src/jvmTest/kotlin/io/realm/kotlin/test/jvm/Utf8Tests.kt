@@ -0,0 +1,153 @@
+/*
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.kotlin.test.jvm
+
+import io.realm.kotlin.Realm
+import io.realm.kotlin.RealmConfiguration
+import io.realm.kotlin.entities.Sample
+import io.realm.kotlin.ext.query
+import io.realm.kotlin.query.Sort
+import io.realm.kotlin.test.platform.PlatformUtils
+import kotlin.random.Random
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertTrue
+
+/**
+ * Tests of the transcoding of strings between the UTF-16 strings of the JVM and the UTF-8 strings
+ * of Core, see `utf8.hpp`. Runs of ASCII characters are transcoded in blocks of 8 and 16
+ * characters, so strings are built to place other characters before, inside and after such
+ * blocks.
+ */
+class Utf8Tests {
+
+    private lateinit var tmpDir: String
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        val configuration = RealmConfiguration.Builder(setOf(Sample::class))
+            .directory(tmpDir)
+            .build()
+        realm = Realm.open(configuration)
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (this::realm.isInitialized && !realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun roundTrip_asciiRunsAcrossBlockBoundaries() {
+        val strings = (0..40).flatMap { length ->
+            val run = asciiRun(length)
+            listOf(
+                run,
+                "${run}é",
+                "$run€$run",
+                "$run😀$run",
+                "é$run",
+                "中$run\u0080"
+            )
+        }
+        assertRoundTrip(strings)
+    }
+
+    @Test
+    fun roundTrip_randomStrings() {
+        val random = Random(SEED)
+        val strings = List(500) { randomString(random, random.nextInt(0, 200)) } +
+            List(5) { randomString(random, random.nextInt(5_000, 20_000)) }
+        assertRoundTrip(strings)
+    }
+
+    @Test
+    fun invalidSurrogatesThrow() {
+        (0..40).forEach { length ->
+            val run = asciiRun(length)
+            listOf(
+                "$run\uD800",
+                "$run\uDC00$run",
+                "$run\uD800$run",
+                "$run\uD800𐀀",
+                "é$run\uDFFF"
+            ).forEach { invalid ->
+                assertFailsWith<IllegalArgumentException>("Invalid string accepted: $invalid") {
+                    realm.writeBlocking {
+                        copyToRealm(Sample().apply { stringField = invalid })
+                    }
+                }
+            }
+        }
+        assertEquals(0, realm.query<Sample>().count().find())
+    }
+
+    // Writes the strings and reads them back, which transcodes them to UTF-8 and back to UTF-16.
+    // Querying for each string transcodes the query arguments as well.
+    private fun assertRoundTrip(strings: List<String>) {
+        realm.writeBlocking {
+            strings.forEachIndexed { i, string ->
+                copyToRealm(
+                    Sample().apply {
+                        intField = i
+                        stringField = string
+                    }
+                )
+            }
+        }
+        val read = realm.query<Sample>().sort("intField", Sort.ASCENDING).find()
+            .map { it.stringField }
+        assertEquals(strings, read)
+        strings.forEachIndexed { i, string ->
+            val matches = realm.query<Sample>("stringField == $0", string).find().map { it.intField }
+            assertTrue(i in matches, "Query failed for: $string")
+        }
+    }
+
+    private fun asciiRun(length: Int): String =
+        String(CharArray(length) { (0x20 + it % 0x5f).toChar() })
+
+    // Mixes runs of ASCII characters with characters encoded as two, three and four bytes
+    private fun randomString(random: Random, length: Int): String {
+        val builder = StringBuilder()
+        while (builder.length < length) {
+            when (random.nextInt(4)) {
+                0 -> repeat(random.nextInt(1, 40)) { builder.append(random.nextInt(1, 0x80).toChar()) }
+                1 -> builder.appendCodePoint(random.nextInt(0x80, 0x800))
+                2 -> builder.appendCodePoint(
+                    random.nextInt(0x800, 0x10000 - SURROGATE_COUNT).let {
+                        if (it >= Char.MIN_SURROGATE.code) it + SURROGATE_COUNT else it
+                    }
+                )
+                else -> builder.appendCodePoint(random.nextInt(0x10000, 0x110000))
+            }
+        }
+        return builder.toString()
+    }
+
+    companion object {
+        private const val SEED = 42
+        private const val SURROGATE_COUNT = 0x800
+    }
+}
@@ -248,6 +248,8 @@ kotlin {
                 implementation(kotlin("test"))
                 implementation(kotlin("test-junit"))
                 implementation(kotlin("reflect"))
+                // Fake OkHttp clients for the platform networking tests
+                implementation("io.ktor:ktor-client-okhttp:${Versions.ktor}")
             }
         }
     }
@@ -3,11 +3,19 @@ package io.realm.kotlin.test.mongodb.jvm
 import io.realm.kotlin.Realm
 import io.realm.kotlin.entities.sync.SyncObjectWithAllTypes
 import io.realm.kotlin.ext.query
+import io.realm.kotlin.internal.interop.LongPointerWrapper
+import io.realm.kotlin.internal.interop.RealmInterop
+import io.realm.kotlin.internal.interop.RealmWebsocketHandlerCallbackPointer
+import io.realm.kotlin.internal.interop.realmc
+import io.realm.kotlin.internal.interop.sync.ByteBufferWebSocketClient
+import io.realm.kotlin.internal.interop.sync.WebSocketObserver
+import io.realm.kotlin.internal.interop.sync.WebsocketEngine
 import io.realm.kotlin.internal.platform.runBlocking
 import io.realm.kotlin.log.LogCategory
 import io.realm.kotlin.log.LogLevel
 import io.realm.kotlin.log.RealmLog
 import io.realm.kotlin.mongodb.User
+import io.realm.kotlin.mongodb.internal.OkHttpWebsocketClient
 import io.realm.kotlin.mongodb.sync.SyncConfiguration
 import io.realm.kotlin.mongodb.syncSession
 import io.realm.kotlin.test.mongodb.TestApp
@@ -17,12 +25,30 @@ import io.realm.kotlin.test.mongodb.createUserAndLogIn
 import io.realm.kotlin.test.mongodb.use
 import io.realm.kotlin.test.mongodb.util.DefaultFlexibleSyncAppInitializer
 import io.realm.kotlin.test.util.use
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.ExecutorCoroutineDispatcher
+import kotlinx.coroutines.asCoroutineDispatcher
 import kotlinx.coroutines.flow.first
 import kotlinx.coroutines.withTimeout
+import okhttp3.OkHttpClient
+import okhttp3.Protocol
+import okhttp3.Request
+import okhttp3.Response
+import okhttp3.WebSocket
+import okhttp3.WebSocketListener
+import okio.ByteString
+import okio.ByteString.Companion.encodeUtf8
+import java.nio.ByteBuffer
+import java.util.concurrent.CopyOnWriteArrayList
+import java.util.concurrent.Executors
+import kotlin.random.Random
 import kotlin.test.Ignore
 import kotlin.test.Test
+import kotlin.test.assertContentEquals
 import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
 import kotlin.test.assertTrue
+import kotlin.test.fail
 import kotlin.time.Duration.Companion.seconds
 
 class PlatformNetworkingTests {
@@ -83,6 +109,197 @@ class PlatformNetworkingTests {
         }
     }
 
+    @Test
+    fun syncRoundTrip_platformNetworking_largeMessage() = runBlocking {
+        TestApp(this::class.simpleName, DefaultFlexibleSyncAppInitializer, builder = {
+            it.usePlatformNetworking(true)
+        }).use { app ->
+            val selector = org.mongodb.kbson.ObjectId().toString()
+            // Larger than the direct receive buffer, so the message downloading it is passed to
+            // Core as a byte array, while all other messages are read from the direct buffer
+            val payload = Random.nextBytes(2 * MAX_RECEIVE_BUFFER_SIZE)
+
+            val logger = CustomLogCollector()
+            RealmLog.add(logger)
+            RealmLog.setLevel(LogLevel.TRACE, LogCategory.Realm.Sdk)
+            try {
+                Realm.open(createSyncConfig(app.createUserAndLogIn(), selector))
+                    .use { uploadRealm ->
+                        Realm.open(createSyncConfig(app.createUserAndLogIn(), selector))
+                            .use { realm ->
+                                uploadRealm.write {
+                                    copyToRealm(
+                                        SyncObjectWithAllTypes().apply {
+                                            stringField = selector
+                                            binaryField = payload
+                                        }
+                                    )
+                                }
+                                uploadRealm.syncSession.uploadAllLocalChanges(TIMEOUT)
+                                withTimeout(TIMEOUT) {
+                                    realm.query<SyncObjectWithAllTypes>().asFlow().first {
+                                        it.list.size == 1
+                                    }.list.first().also {
+                                        assertContentEquals(payload, it.binaryField)
+                                    }
+                                }
+                            }
+                    }
+            } finally {
+                RealmLog.remove(logger)
+            }
+            val messageSizes = logger.logs.mapNotNull { log ->
+                "\\[Websocket.*\\] onMessage: (\\d+) bytes".toRegex().find(log)?.groupValues?.get(1)?.toInt()
+            }
+            assertTrue(messageSizes.any { it > MAX_RECEIVE_BUFFER_SIZE }, "No large message: $messageSizes")
+            assertTrue(messageSizes.any { it <= MAX_RECEIVE_BUFFER_SIZE }, "No small message: $messageSizes")
+        }
+    }
+
+    @Test
+    fun byteBufferSend_frameIsCopiedBeforeSendReturns() {
+        withRecordingClient { client, webSocket, dispatcher ->
+            val frame = Random.nextBytes(4096)
+            val inFlight = writePoolStats().inFlight
+            // Clobbers the frame once send returns, like Core freeing it with the websocket
+            realmc.realm_sync_websocket_write_for_testing(client, frame)
+            // Waits for the frame queued on the transport to be sent
+            runBlocking(dispatcher) { }
+            assertContentEquals(frame, webSocket.frames.single().toByteArray())
+            assertEquals(inFlight, writePoolStats().inFlight)
+        }
+    }
+
+    @Test
+    fun byteBufferSend_failingSendCompletesWrite() {
+        var readOnly = false
+        val client = object : ByteBufferWebSocketClient {
+            override fun send(message: ByteBuffer, writeId: Long) {
+                readOnly = message.isReadOnly
+                throw IllegalStateException("Failing send")
+            }
+            override fun send(message: ByteArray, handlerCallback: RealmWebsocketHandlerCallbackPointer) =
+                fail("Unexpected byte array send")
+            override fun close() = Unit
+        }
+        val inFlight = writePoolStats().inFlight
+        realmc.realm_sync_websocket_write_for_testing(client, Random.nextBytes(16))
+        assertTrue(readOnly)
+        // The write is completed as failed and its slot released
+        assertEquals(inFlight, writePoolStats().inFlight)
+    }
+
+    @Test
+    fun directMessage_rejectsBuffersNotHoldingTheMessage() {
+        // Rejected before the observer is accessed
+        assertFailsWith<IllegalArgumentException> {
+            realmc.realm_sync_websocket_message_direct(0, ByteBuffer.allocate(16), 0, 16)
+        }
+        assertFailsWith<IllegalArgumentException> {
+            realmc.realm_sync_websocket_message_direct(0, ByteBuffer.allocateDirect(16), 8, 16)
+        }
+    }
+
+    @Test
+    fun writePool_reusesCompletedWrites() {
+        val write = realmc.realm_sync_websocket_write_acquire_for_testing()
+        RealmInterop.realm_sync_socket_write_complete(write, false)
+        val stats = writePoolStats()
+        repeat(100) {
+            val next = realmc.realm_sync_websocket_write_acquire_for_testing()
+            assertEquals(write, next)
+            RealmInterop.realm_sync_socket_write_complete(next, false)
+        }
+        assertEquals(stats, writePoolStats())
+    }
+
+    @Test
+    fun writePool_growsWithWritesInFlight() {
+        val initial = writePoolStats()
+        val writes = List(64) { realmc.realm_sync_websocket_write_acquire_for_testing() }
+        assertEquals(64, writes.toSet().size)
+        val grown = writePoolStats()
+        assertEquals(initial.inFlight + 64, grown.inFlight)
+        assertTrue(grown.size >= 64)
+        writes.forEach { RealmInterop.realm_sync_socket_write_complete(it, true) }
+        assertEquals(initial.inFlight, writePoolStats().inFlight)
+
+        // The pool is bounded by the number of writes in flight, so the same number of writes
+        // reuses the completed ones instead of growing it further
+        val reused = List(64) { realmc.realm_sync_websocket_write_acquire_for_testing() }
+        assertEquals(writes.toSet(), reused.toSet())
+        assertEquals(grown, writePoolStats())
+        reused.forEach { RealmInterop.realm_sync_socket_write_complete(it, false) }
+    }
+
+    private companion object {
+        // Size of the direct receive buffer of `OkHttpWebsocketClient`
+        const val MAX_RECEIVE_BUFFER_SIZE = 1024 * 1024
+    }
+
+    private data class WritePoolStats(val size: Long, val inFlight: Long)
+
+    private fun writePoolStats(): WritePoolStats =
+        realmc.realm_sync_websocket_write_pool_stats_for_testing().let { WritePoolStats(it[0], it[1]) }
+
+    // Runs the block with a client connected to a websocket recording the frames sent through it.
+    // The client runs on the returned dispatcher like on the event loop of the transport.
+    private fun withRecordingClient(
+        block: (OkHttpWebsocketClient, RecordingWebSocket, ExecutorCoroutineDispatcher) -> Unit
+    ) {
+        val dispatcher = Executors.newSingleThreadExecutor().asCoroutineDispatcher()
+        val okHttpClient = RecordingOkHttpClient()
+        val client = OkHttpWebsocketClient(
+            WebSocketObserver(LongPointerWrapper(0L, managed = false)),
+            "/",
+            "localhost",
+            80,
+            false,
+            "",
+            object : WebsocketEngine {
+                override fun shutdown() = Unit
+                @Suppress("UNCHECKED_CAST")
+                override fun <T> getInstance(): T = okHttpClient as T
+            },
+            CoroutineScope(dispatcher)
+        ) { _, _, _, _ -> fail("Unexpected handler callback") }
+        try {
+            // Waits for the connection
+            runBlocking(dispatcher) { }
+            block(client, okHttpClient.webSocket, dispatcher)
+        } finally {
+            client.close()
+            dispatcher.close()
+        }
+    }
+
+    private class RecordingOkHttpClient : OkHttpClient() {
+        lateinit var webSocket: RecordingWebSocket
+
+        override fun newWebSocket(request: Request, listener: WebSocketListener): WebSocket {
+            webSocket = RecordingWebSocket(request)
+            val response = Response.Builder()
+                .request(request)
+                .protocol(Protocol.HTTP_1_1)
+                .code(101)
+                .message("Switching Protocols")
+                .build()
+            listener.onOpen(webSocket, response)
+            return webSocket
+        }
+    }
+
+    private class RecordingWebSocket(private val request: Request) : WebSocket {
+        val frames: MutableList<ByteString> = CopyOnWriteArrayList()
+
+        override fun request(): Request = request
+        override fun queueSize(): Long = 0
+        override fun send(text: String): Boolean = send(text.encodeUtf8())
+        override fun send(bytes: ByteString): Boolean = frames.add(bytes)
+        override fun close(code: Int, reason: String?): Boolean = true
+        override fun cancel() = Unit
+    }
+
     private fun createSyncConfig(
         user: User,
         selector: String